@@ -0,0 +1,430 @@
+/*
+    Copyright (c) 2021 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*
+    [자료 구조 성능 측정 프로그램]
+
+    - 값의 추가 (push)와 제거 (pop)로 이루어진 작업 순서 (trace)를 만들고, 각 자료 구조에서
+      그대로 재생하면서 처리량과 지연 시간을 측정한다.
+    - Linux에서는 `perf_event_open()`으로 CPU 사이클, 명령어, 캐시 미스와 분기 예측 실패
+      횟수도 함께 측정한다.
+    - 측정 결과는 한 줄에 하나씩 JSON 객체로 출력한다.
+    - `queue.h`와 `queue._h`는 같은 이름을 사용하므로, `BENCHMARK_ARRAY_QUEUE`를 정의하면
+      `queue.h` 대신 `queue._h`의 큐를 측정한다.
+
+    [사용 방법]
+
+    benchmark [-n 작업 횟수] [-w 초기 항목 개수] [-p 추가 작업의 비율 (%)] [-s 시드] [-t 작업 순서 파일]
+
+    - 작업 순서 파일의 각 줄은 `+<값>` (추가) 또는 `-` (제거)로 이루어진다.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SOKOL_IMPL
+#include "sokol_time.h"
+
+#define BINARY_HEAP_IMPLEMENTATION
+#include "binary_heap.h"
+
+#define LINKED_LIST_IMPLEMENTATION
+#include "linked_list.h"
+
+#define QUEUE_IMPLEMENTATION
+#ifdef BENCHMARK_ARRAY_QUEUE
+    #include "queue._h"
+
+    #define BENCHMARK_QUEUE_NAME "queue._h"
+#else
+    #include "queue.h"
+
+    #define BENCHMARK_QUEUE_NAME "queue.h"
+#endif
+
+#define STACK_IMPLEMENTATION
+#include "stack.h"
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+/* 지연 시간을 측정할 때 한 번에 묶어서 처리하는 작업의 개수. */
+#define BENCHMARK_BATCH_SIZE 64
+
+/* 측정하는 하드웨어 성능 카운터의 개수. */
+#define BENCHMARK_COUNTER_COUNT 4
+
+/* 값을 제거하는 작업을 나타내는 값. */
+#define BENCHMARK_OP_POP -1
+
+/* 작업 순서를 나타내는 구조체. */
+typedef struct Trace {
+    const char *name;
+    int warmup;
+    int length;
+    int *ops;
+} Trace;
+
+/* 측정 결과를 나타내는 구조체. */
+typedef struct Result {
+    uint64_t ticks;
+    uint64_t *batches;
+    long long counters[BENCHMARK_COUNTER_COUNT];
+} Result;
+
+/* 하드웨어 성능 카운터의 이름을 나타내는 배열. */
+static const char *COUNTER_NAMES[BENCHMARK_COUNTER_COUNT] = {
+    "cycles", "instructions", "cache_misses", "branch_misses"
+};
+
+/* 하드웨어 성능 카운터의 파일 디스크립터를 나타내는 배열. */
+static int counter_fds[BENCHMARK_COUNTER_COUNT] = { -1, -1, -1, -1 };
+
+/* 컴파일러가 측정 대상 코드를 제거하지 못하도록 제거한 값을 누적하는 변수. */
+static volatile long long sink;
+
+/* 하드웨어 성능 카운터를 연다. */
+static void counters_open(void) {
+#ifdef __linux__
+    static const uint64_t configs[BENCHMARK_COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < BENCHMARK_COUNTER_COUNT; i++) {
+        struct perf_event_attr attr;
+
+        memset(&attr, 0, sizeof(attr));
+
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        // 권한이 없거나 가상 머신에서 실행 중이면 실패할 수 있으며, 이 경우에는 `null`을 출력한다.
+        counter_fds[i] = (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+}
+
+/* 하드웨어 성능 카운터를 닫는다. */
+static void counters_close(void) {
+#ifdef __linux__
+    for (int i = 0; i < BENCHMARK_COUNTER_COUNT; i++)
+        if (counter_fds[i] >= 0) close(counter_fds[i]);
+#endif
+}
+
+/* 하드웨어 성능 카운터를 초기화하고 측정을 시작한다. */
+static void counters_start(void) {
+#ifdef __linux__
+    for (int i = 0; i < BENCHMARK_COUNTER_COUNT; i++) {
+        if (counter_fds[i] < 0) continue;
+
+        ioctl(counter_fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/* 하드웨어 성능 카운터의 측정을 마치고, 그 값을 `counters`에 저장한다. */
+static void counters_stop(long long *counters) {
+    for (int i = 0; i < BENCHMARK_COUNTER_COUNT; i++)
+        counters[i] = -1;
+
+#ifdef __linux__
+    for (int i = 0; i < BENCHMARK_COUNTER_COUNT; i++) {
+        if (counter_fds[i] < 0) continue;
+
+        ioctl(counter_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        uint64_t value = 0;
+
+        if (read(counter_fds[i], &value, sizeof(value)) == sizeof(value))
+            counters[i] = (long long) value;
+    }
+#endif
+}
+
+/*
+    작업 순서 `trace`를 자료 구조에서 재생하는 함수 `name`을 정의한다.
+
+    - 재생 도중에 함수 포인터를 거치지 않도록, 자료 구조마다 따로 함수를 만든다.
+    - 처음 `trace->warmup`개의 작업은 측정하지 않는다.
+*/
+#define BENCHMARK_DEFINE_REPLAY(name, type, create, push, pop, release)          \
+    static void name(const Trace *trace, Result *result) {                        \
+        type *container = create();                                               \
+                                                                                  \
+        for (int i = 0; i < trace->warmup; i++) {                                 \
+            if (trace->ops[i] != BENCHMARK_OP_POP) push(container, trace->ops[i]); \
+            else sink += pop(container);                                          \
+        }                                                                         \
+                                                                                  \
+        counters_start();                                                         \
+                                                                                  \
+        uint64_t start_time = stm_now();                                          \
+                                                                                  \
+        for (int i = trace->warmup, j = 0; i < trace->length; j++) {              \
+            int end = i + BENCHMARK_BATCH_SIZE;                                   \
+                                                                                  \
+            if (end > trace->length) end = trace->length;                         \
+                                                                                  \
+            uint64_t batch_time = stm_now();                                      \
+                                                                                  \
+            for (; i < end; i++) {                                                \
+                if (trace->ops[i] != BENCHMARK_OP_POP) push(container, trace->ops[i]); \
+                else sink += pop(container);                                      \
+            }                                                                     \
+                                                                                  \
+            result->batches[j] = stm_since(batch_time);                           \
+        }                                                                         \
+                                                                                  \
+        result->ticks = stm_since(start_time);                                    \
+                                                                                  \
+        counters_stop(result->counters);                                          \
+                                                                                  \
+        release(container);                                                       \
+    }
+
+BENCHMARK_DEFINE_REPLAY(replay_stack, Stack, stack_create, stack_push, stack_pop, stack_release)
+BENCHMARK_DEFINE_REPLAY(replay_queue, Queue, queue_create, queue_push, queue_pop, queue_release)
+BENCHMARK_DEFINE_REPLAY(replay_binary_heap, BinaryHeap, binary_heap_create, binary_heap_push, binary_heap_pop, binary_heap_release)
+BENCHMARK_DEFINE_REPLAY(replay_sll, SinglyLinkedList, sll_create, sll_push_back, sll_pop_front, sll_release)
+
+/* 작업 순서를 재생하는 함수를 나타내는 타입. */
+typedef void (*ReplayFunc)(const Trace *trace, Result *result);
+
+/* 두 측정 시간 `a`와 `b`를 비교한다. */
+static int compare_ticks(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+/* 길이가 `count`인 측정 시간 배열 `ptr`에서 `percentile`번째 백분위수를 반환한다. */
+static uint64_t percentile_of(uint64_t *ptr, int count, double percentile) {
+    int index = (int) (percentile / 100.0 * (count - 1) + 0.5);
+
+    return ptr[index];
+}
+
+/* 문자열 `str`을 JSON 문자열로 출력한다. */
+static void print_json_string(const char *str) {
+    putchar('"');
+
+    for (; *str != '\0'; str++) {
+        unsigned char c = (unsigned char) *str;
+
+        if (c == '"' || c == '\\') printf("\\%c", c);
+        else if (c < 0x20) printf("\\u%04x", c);
+        else putchar(c);
+    }
+
+    putchar('"');
+}
+
+/* 작업 순서 `trace`를 자료 구조 `container`에서 재생하고, 그 결과를 출력한다. */
+static void run(const char *container, ReplayFunc replay, const Trace *trace) {
+    int ops = trace->length - trace->warmup;
+
+    if (ops <= 0) return;
+
+    int batch_count = (ops + BENCHMARK_BATCH_SIZE - 1) / BENCHMARK_BATCH_SIZE;
+
+    Result result = { 0 };
+
+    result.batches = calloc(batch_count, sizeof(uint64_t));
+
+    replay(trace, &result);
+
+    /*
+        지연 시간 분포는 `BENCHMARK_BATCH_SIZE`개씩 묶은 작업의 평균 시간으로 계산한다.
+
+        - 마지막 묶음은 크기가 다를 수 있으므로, 지연 시간 분포에서 제외한다.
+        - 온전한 묶음이 하나도 없으면, 백분위수 대신 `null`을 출력한다.
+    */
+    int full_batches = ops / BENCHMARK_BATCH_SIZE;
+
+    qsort(result.batches, full_batches, sizeof(uint64_t), compare_ticks);
+
+    double ns_per_op = stm_ns(result.ticks) / ops;
+    double batch_ns = (double) BENCHMARK_BATCH_SIZE;
+
+    printf("{\"container\": \"%s\", \"trace\": ", container);
+
+    print_json_string(trace->name);
+
+    printf(
+        ", \"ops\": %d, \"ns_per_op\": %.3f, \"mops_per_sec\": %.3f",
+        ops, ns_per_op, (ns_per_op > 0.0) ? 1000.0 / ns_per_op : 0.0
+    );
+
+    if (full_batches > 0) {
+        printf(
+            ", \"batch_p50_ns_per_op\": %.3f, \"batch_p99_ns_per_op\": %.3f, \"batch_max_ns_per_op\": %.3f",
+            stm_ns(percentile_of(result.batches, full_batches, 50.0)) / batch_ns,
+            stm_ns(percentile_of(result.batches, full_batches, 99.0)) / batch_ns,
+            stm_ns(result.batches[full_batches - 1]) / batch_ns
+        );
+    } else {
+        printf(", \"batch_p50_ns_per_op\": null, \"batch_p99_ns_per_op\": null, \"batch_max_ns_per_op\": null");
+    }
+
+    for (int i = 0; i < BENCHMARK_COUNTER_COUNT; i++) {
+        if (result.counters[i] >= 0) printf(", \"%s\": %lld", COUNTER_NAMES[i], result.counters[i]);
+        else printf(", \"%s\": null", COUNTER_NAMES[i]);
+    }
+
+    printf("}\n");
+
+    free(result.batches);
+}
+
+/*
+    초기 항목 `warmup`개를 추가한 다음, 추가 작업의 비율이 `push_percent`%인 작업을 `count`번
+    무작위로 수행하는 작업 순서를 만든다.
+*/
+static Trace trace_create_mixed(const char *name, int warmup, int count, int push_percent) {
+    Trace result = { name, warmup, warmup + count, NULL };
+
+    result.ops = malloc(result.length * sizeof(int));
+
+    int size = 0;
+
+    for (int i = 0; i < result.length; i++) {
+        // 빈 자료 구조에서는 값을 제거하지 않는다.
+        if (i < warmup || size == 0 || rand() % 100 < push_percent) {
+            result.ops[i] = rand() & 0x3fffffff;
+            size++;
+        } else {
+            result.ops[i] = BENCHMARK_OP_POP;
+            size--;
+        }
+    }
+
+    return result;
+}
+
+/* 값을 `count`개 추가한 다음, 다시 모두 제거하는 작업 순서를 만든다. */
+static Trace trace_create_fill_drain(int count) {
+    Trace result = { "fill_drain", 0, 2 * count, NULL };
+
+    result.ops = malloc(result.length * sizeof(int));
+
+    for (int i = 0; i < count; i++) {
+        result.ops[i] = rand() & 0x3fffffff;
+        result.ops[count + i] = BENCHMARK_OP_POP;
+    }
+
+    return result;
+}
+
+/* 파일 `path`에서 작업 순서를 읽는다. */
+static Trace trace_load(const char *path) {
+    Trace result = { path, 0, 0, NULL };
+
+    FILE *fp = fopen(path, "r");
+
+    if (fp == NULL) {
+        fprintf(stderr, "benchmark: cannot open trace file `%s`\n", path);
+
+        return result;
+    }
+
+    int capacity = 1024;
+
+    result.ops = malloc(capacity * sizeof(int));
+
+    char line[64];
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (line[0] != '+' && line[0] != '-') continue;
+
+        if (result.length >= capacity) {
+            capacity *= 2;
+            result.ops = realloc(result.ops, capacity * sizeof(int));
+        }
+
+        result.ops[result.length++] = (line[0] == '+') ? (atoi(line + 1) & 0x3fffffff) : BENCHMARK_OP_POP;
+    }
+
+    fclose(fp);
+
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+    int count = 1000000, warmup = 1024, push_percent = 50;
+    unsigned int seed = 2021;
+    const char *trace_path = NULL;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-n") == 0) count = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-w") == 0) warmup = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-p") == 0) push_percent = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-s") == 0) seed = (unsigned int) atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-t") == 0) trace_path = argv[i + 1];
+    }
+
+    if (count <= 0 || warmup < 0 || push_percent < 0 || push_percent > 100) {
+        fprintf(stderr, "benchmark: invalid arguments\n");
+
+        return 1;
+    }
+
+    stm_setup();
+    srand(seed);
+
+    counters_open();
+
+    Trace traces[3];
+    int trace_count = 0;
+
+    if (trace_path != NULL) {
+        traces[trace_count++] = trace_load(trace_path);
+    } else {
+        traces[trace_count++] = trace_create_fill_drain(count / 2);
+        traces[trace_count++] = trace_create_mixed("mixed", warmup, count, push_percent);
+
+        // 추가와 제거의 비율을 같게 하여, 자료 구조의 크기가 크게 바뀌지 않도록 한다.
+        traces[trace_count++] = trace_create_mixed("steady", warmup, count, 50);
+    }
+
+    for (int i = 0; i < trace_count; i++) {
+        run("stack", replay_stack, &traces[i]);
+        run(BENCHMARK_QUEUE_NAME, replay_queue, &traces[i]);
+        run("binary_heap", replay_binary_heap, &traces[i]);
+        run("sll", replay_sll, &traces[i]);
+
+        free(traces[i].ops);
+    }
+
+    counters_close();
+
+    return 0;
+}
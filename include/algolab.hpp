@@ -0,0 +1,880 @@
+/*
+    Copyright (c) 2021 jdeokkim
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef ALGOLAB_HPP
+#define ALGOLAB_HPP
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "stats.h"
+
+/* 컨테이너 객체 안에 직접 저장할 수 있는 값의 기본 최대 개수. */
+#ifndef ALGOLAB_INLINE_CAPACITY
+    #define ALGOLAB_INLINE_CAPACITY 8
+#endif
+
+/* 자동으로 정렬 엔진을 고를 때, 삽입 정렬을 사용할 배열의 최대 길이. */
+#ifndef ALGOLAB_SMALL_SORT_THRESHOLD
+    #define ALGOLAB_SMALL_SORT_THRESHOLD 16
+#endif
+
+namespace algolab {
+
+/* 배열의 길이를 컴파일 시간에 알 수 없음을 나타내는 값. */
+inline constexpr std::size_t dynamic_extent = static_cast<std::size_t>(-1);
+
+/* 연속된 메모리 공간에 저장된 값들을 가리키는 클래스. */
+template <typename T>
+class span {
+public:
+    constexpr span() noexcept : ptr_(nullptr), size_(0) {}
+    
+    constexpr span(T *ptr, std::size_t size) noexcept : ptr_(ptr), size_(size) {}
+    
+    template <std::size_t N>
+    constexpr span(T (&array)[N]) noexcept : ptr_(array), size_(N) {}
+    
+    constexpr T *data() const noexcept { return ptr_; }
+    
+    constexpr std::size_t size() const noexcept { return size_; }
+    
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    
+    constexpr T &operator[](std::size_t index) const noexcept { return ptr_[index]; }
+    
+    constexpr T *begin() const noexcept { return ptr_; }
+    
+    constexpr T *end() const noexcept { return ptr_ + size_; }
+
+private:
+    T *ptr_;
+    std::size_t size_;
+};
+
+namespace detail {
+
+/* 
+    값을 `N`개까지는 객체 안의 내장 버퍼에 저장하고, 그보다 많으면 할당자로 할당한 메모리에
+    저장하는 버퍼.
+    
+    - 버퍼는 메모리만 관리하며, 값의 생성과 소멸은 버퍼를 사용하는 컨테이너가 담당한다.
+*/
+template <typename T, std::size_t N>
+class buffer {
+    static_assert(N > 0, "the inline capacity must be positive");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+public:
+    explicit buffer(const Allocator *allocator) noexcept 
+        : ptr_(inline_ptr()), capacity_(N), allocator_() {
+        if (allocator != nullptr) allocator_ = *allocator;
+    }
+    
+    buffer(const buffer &) = delete;
+    
+    buffer &operator=(const buffer &) = delete;
+    
+    ~buffer() { release(); }
+    
+    T *data() const noexcept { return ptr_; }
+    
+    std::size_t capacity() const noexcept { return capacity_; }
+    
+    const Allocator *allocator() const noexcept { return &allocator_; }
+    
+    bool is_inline() const noexcept { return ptr_ == inline_ptr(); }
+    
+    /* 
+        버퍼의 용량을 `capacity`로 바꾸고, `ptr[first..(first + count - 1)]`에 있는 값을 
+        `ptr[to..(to + count - 1)]`로 옮긴다.
+    */
+    bool relocate(std::size_t capacity, std::size_t first, std::size_t count, std::size_t to) {
+        if (capacity <= N) capacity = N;
+        
+        // 용량이 그대로이면, 같은 메모리 공간 안에서 값을 옮기기만 한다.
+        if (capacity == capacity_) {
+            shift(ptr_, first, count, to);
+            
+            return true;
+        }
+        
+        T *ptr = nullptr;
+        
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // 복사가 간단한 값은 C 헤더와 같이 메모리를 통째로 재할당한다.
+            if (capacity > N && !is_inline() && first == to) {
+                ptr = static_cast<T *>(
+                    allocator_realloc(&allocator_, ptr_, capacity_ * sizeof(T), capacity * sizeof(T))
+                );
+                
+                if (ptr == nullptr) return false;
+                
+                ptr_ = ptr;
+                capacity_ = capacity;
+                
+                return true;
+            }
+        }
+        
+        if (capacity > N) {
+            ptr = static_cast<T *>(allocator_alloc(&allocator_, capacity * sizeof(T)));
+            
+            if (ptr == nullptr) return false;
+        } else {
+            ptr = inline_ptr();
+        }
+        
+        for (std::size_t i = 0; i < count; i++) {
+            ::new (static_cast<void *>(ptr + to + i)) T(std::move(ptr_[first + i]));
+            
+            ptr_[first + i].~T();
+        }
+        
+        STATS_ADD(moves, count);
+        
+        release();
+        
+        ptr_ = ptr;
+        capacity_ = capacity;
+        
+        return true;
+    }
+    
+    /* 
+        버퍼 `other`의 `ptr[first..(first + count - 1)]`에 있는 값을 이 버퍼의 
+        `ptr[to..(to + count - 1)]`로 가져온다. 이 버퍼는 비어 있어야 한다.
+    */
+    void steal(buffer &other, std::size_t first, std::size_t count, std::size_t to) noexcept {
+        allocator_ = other.allocator_;
+        
+        if (!other.is_inline()) {
+            // 할당한 메모리는 주소만 넘겨받는다.
+            ptr_ = other.ptr_;
+            capacity_ = other.capacity_;
+            
+            other.ptr_ = other.inline_ptr();
+            other.capacity_ = N;
+            
+            if (first != to) shift(ptr_, first, count, to);
+            
+            return;
+        }
+        
+        for (std::size_t i = 0; i < count; i++) {
+            ::new (static_cast<void *>(ptr_ + to + i)) T(std::move(other.ptr_[first + i]));
+            
+            other.ptr_[first + i].~T();
+        }
+    }
+    
+    /* 내장 버퍼 밖에 할당한 메모리를 해제한다. */
+    void release() noexcept {
+        if (!is_inline()) allocator_free(&allocator_, ptr_, capacity_ * sizeof(T));
+        
+        ptr_ = inline_ptr();
+        capacity_ = N;
+    }
+
+private:
+    T *ptr_;
+    std::size_t capacity_;
+    Allocator allocator_;
+    alignas(T) unsigned char inline_ptr_[N * sizeof(T)];
+    
+    T *inline_ptr() const noexcept {
+        return reinterpret_cast<T *>(const_cast<unsigned char *>(inline_ptr_));
+    }
+    
+    /* 같은 메모리 공간 안에서 `ptr[first..(first + count - 1)]`에 있는 값을 `ptr[to..]`로 옮긴다. */
+    static void shift(T *ptr, std::size_t first, std::size_t count, std::size_t to) {
+        if (first == to || count == 0) return;
+        
+        if (to < first) {
+            for (std::size_t i = 0; i < count; i++) {
+                // 아직 값이 생성되지 않은 자리에는 새로 생성하고, 그렇지 않으면 값을 덮어쓴다.
+                if (to + i < first) ::new (static_cast<void *>(ptr + to + i)) T(std::move(ptr[first + i]));
+                else ptr[to + i] = std::move(ptr[first + i]);
+            }
+            
+            for (std::size_t i = (first > to + count) ? first : to + count; i < first + count; i++)
+                ptr[i].~T();
+        } else {
+            for (std::size_t i = count; i-- > 0;) {
+                if (to + i >= first + count) ::new (static_cast<void *>(ptr + to + i)) T(std::move(ptr[first + i]));
+                else ptr[to + i] = std::move(ptr[first + i]);
+            }
+            
+            for (std::size_t i = first; i < to && i < first + count; i++)
+                ptr[i].~T();
+        }
+        
+        STATS_ADD(moves, count);
+    }
+};
+
+}
+
+/* 
+    `T` 타입의 값을 저장하는 스택 클래스.
+    
+    - `stack.h`와 같이 값을 `N`개까지는 객체 안에 직접 저장하고, 그보다 많으면 
+      용량을 두 배씩 늘린다.
+    - 메모리를 할당하지 못하면 `push()`와 `emplace()`는 값을 추가하지 않고 `false`를 반환한다.
+*/
+template <typename T, std::size_t N = ALGOLAB_INLINE_CAPACITY>
+class stack {
+public:
+    using value_type = T;
+    
+    stack() noexcept : buffer_(nullptr), length_(0) {}
+    
+    explicit stack(const Allocator *allocator) noexcept : buffer_(allocator), length_(0) {}
+    
+    stack(stack &&other) noexcept : buffer_(nullptr), length_(other.length_) {
+        buffer_.steal(other.buffer_, 0, other.length_, 0);
+        
+        other.length_ = 0;
+    }
+    
+    stack &operator=(stack &&other) noexcept {
+        if (this != &other) {
+            clear();
+            
+            buffer_.release();
+            buffer_.steal(other.buffer_, 0, other.length_, 0);
+            
+            length_ = other.length_;
+            other.length_ = 0;
+        }
+        
+        return *this;
+    }
+    
+    stack(const stack &) = delete;
+    
+    stack &operator=(const stack &) = delete;
+    
+    ~stack() { clear(); }
+    
+    /* 스택에 들어 있는 값의 개수를 반환한다. */
+    std::size_t size() const noexcept { return length_; }
+    
+    /* 스택이 비어 있는지 확인한다. */
+    bool empty() const noexcept { return length_ == 0; }
+    
+    /* 스택이 값을 `count`개까지 담을 수 있도록 공간을 확보한다. */
+    bool reserve(std::size_t count) {
+        return (count <= buffer_.capacity()) || buffer_.relocate(count, 0, length_, 0);
+    }
+    
+    /* 스택이 사용하지 않는 공간을 해제한다. */
+    void shrink_to_fit() {
+        if (length_ < buffer_.capacity()) buffer_.relocate(length_, 0, length_, 0);
+    }
+    
+    /* 스택에 들어 있는 모든 값을 제거한다. */
+    void clear() noexcept {
+        T *ptr = buffer_.data();
+        
+        for (std::size_t i = 0; i < length_; i++)
+            ptr[i].~T();
+        
+        length_ = 0;
+    }
+    
+    /* 스택에 값 `value`를 추가한다. */
+    bool push(const T &value) { return emplace(value); }
+    
+    /* 스택에 값 `value`를 추가한다. */
+    bool push(T &&value) { return emplace(std::move(value)); }
+    
+    /* 스택에 인자 `args`로 생성한 값을 추가한다. */
+    template <typename... Args>
+    bool emplace(Args &&...args) {
+        if (length_ >= buffer_.capacity()) {
+            // 인자가 스택 안의 값을 가리킬 수도 있으므로, 값을 먼저 생성한 다음 공간을 늘린다.
+            T value(std::forward<Args>(args)...);
+            
+            if (!buffer_.relocate(2 * buffer_.capacity(), 0, length_, 0)) return false;
+            
+            ::new (static_cast<void *>(buffer_.data() + length_)) T(std::move(value));
+        } else {
+            ::new (static_cast<void *>(buffer_.data() + length_)) T(std::forward<Args>(args)...);
+        }
+        
+        length_++;
+        
+        return true;
+    }
+    
+    /* 스택에서 가장 마지막에 추가된 값을 제거하고, 그 값을 반환한다. 스택은 비어 있으면 안 된다. */
+    T pop() {
+        T *ptr = buffer_.data() + (--length_);
+        
+        T result(std::move(*ptr));
+        
+        ptr->~T();
+        
+        return result;
+    }
+    
+    /* 스택에서 가장 마지막에 추가된 값을 반환한다. 스택은 비어 있으면 안 된다. */
+    T &top() noexcept { return buffer_.data()[length_ - 1]; }
+    
+    /* 스택에서 가장 마지막에 추가된 값을 반환한다. 스택은 비어 있으면 안 된다. */
+    const T &top() const noexcept { return buffer_.data()[length_ - 1]; }
+
+private:
+    detail::buffer<T, N> buffer_;
+    std::size_t length_;
+};
+
+/* 
+    `T` 타입의 값을 저장하는 큐 클래스.
+    
+    - `queue._h`와 같이 값을 연속된 배열에 추가된 순서대로 저장한다.
+    - 값을 제거할 때마다 배열 전체를 당기는 대신 첫 번째 값의 위치만 옮기고, 배열의 끝에 
+      더 이상 값을 추가할 수 없을 때 한꺼번에 당기거나 용량을 두 배로 늘린다.
+*/
+template <typename T, std::size_t N = ALGOLAB_INLINE_CAPACITY>
+class queue {
+public:
+    using value_type = T;
+    
+    queue() noexcept : buffer_(nullptr), first_(0), length_(0) {}
+    
+    explicit queue(const Allocator *allocator) noexcept : buffer_(allocator), first_(0), length_(0) {}
+    
+    queue(queue &&other) noexcept : buffer_(nullptr), first_(0), length_(other.length_) {
+        buffer_.steal(other.buffer_, other.first_, other.length_, 0);
+        
+        other.first_ = other.length_ = 0;
+    }
+    
+    queue &operator=(queue &&other) noexcept {
+        if (this != &other) {
+            clear();
+            
+            buffer_.release();
+            buffer_.steal(other.buffer_, other.first_, other.length_, 0);
+            
+            length_ = other.length_;
+            other.first_ = other.length_ = 0;
+        }
+        
+        return *this;
+    }
+    
+    queue(const queue &) = delete;
+    
+    queue &operator=(const queue &) = delete;
+    
+    ~queue() { clear(); }
+    
+    /* 큐에 들어 있는 값의 개수를 반환한다. */
+    std::size_t size() const noexcept { return length_; }
+    
+    /* 큐가 비어 있는지 확인한다. */
+    bool empty() const noexcept { return length_ == 0; }
+    
+    /* 큐가 값을 `count`개까지 담을 수 있도록 공간을 확보한다. */
+    bool reserve(std::size_t count) {
+        if (first_ + count <= buffer_.capacity()) return true;
+        
+        if (count < buffer_.capacity()) count = buffer_.capacity();
+        
+        if (!buffer_.relocate(count, first_, length_, 0)) return false;
+        
+        first_ = 0;
+        
+        return true;
+    }
+    
+    /* 큐가 사용하지 않는 공간을 해제한다. */
+    void shrink_to_fit() {
+        if (length_ < buffer_.capacity() && buffer_.relocate(length_, first_, length_, 0)) first_ = 0;
+    }
+    
+    /* 큐에 들어 있는 모든 값을 제거한다. */
+    void clear() noexcept {
+        T *ptr = buffer_.data() + first_;
+        
+        for (std::size_t i = 0; i < length_; i++)
+            ptr[i].~T();
+        
+        first_ = length_ = 0;
+    }
+    
+    /* 큐에 값 `value`를 추가한다. */
+    bool push(const T &value) { return emplace(value); }
+    
+    /* 큐에 값 `value`를 추가한다. */
+    bool push(T &&value) { return emplace(std::move(value)); }
+    
+    /* 큐에 인자 `args`로 생성한 값을 추가한다. */
+    template <typename... Args>
+    bool emplace(Args &&...args) {
+        if (first_ + length_ >= buffer_.capacity()) {
+            T value(std::forward<Args>(args)...);
+            
+            std::size_t capacity = buffer_.capacity();
+            
+            // 배열의 앞쪽 절반 이상이 비어 있으면 값을 당기기만 하고, 그렇지 않으면 용량을 늘린다.
+            if (2 * length_ > capacity) capacity *= 2;
+            
+            if (!buffer_.relocate(capacity, first_, length_, 0)) return false;
+            
+            first_ = 0;
+            
+            ::new (static_cast<void *>(buffer_.data() + length_)) T(std::move(value));
+        } else {
+            ::new (static_cast<void *>(buffer_.data() + first_ + length_)) T(std::forward<Args>(args)...);
+        }
+        
+        length_++;
+        
+        return true;
+    }
+    
+    /* 큐에서 가장 처음에 추가된 값을 제거하고, 그 값을 반환한다. 큐는 비어 있으면 안 된다. */
+    T pop() {
+        T *ptr = buffer_.data() + first_;
+        
+        T result(std::move(*ptr));
+        
+        ptr->~T();
+        
+        first_ = (--length_ > 0) ? first_ + 1 : 0;
+        
+        return result;
+    }
+    
+    /* 큐에서 가장 처음에 추가된 값을 반환한다. 큐는 비어 있으면 안 된다. */
+    T &front() noexcept { return buffer_.data()[first_]; }
+    
+    /* 큐에서 가장 처음에 추가된 값을 반환한다. 큐는 비어 있으면 안 된다. */
+    const T &front() const noexcept { return buffer_.data()[first_]; }
+    
+    /* 큐에서 가장 마지막에 추가된 값을 반환한다. 큐는 비어 있으면 안 된다. */
+    T &back() noexcept { return buffer_.data()[first_ + length_ - 1]; }
+    
+    /* 큐에서 가장 마지막에 추가된 값을 반환한다. 큐는 비어 있으면 안 된다. */
+    const T &back() const noexcept { return buffer_.data()[first_ + length_ - 1]; }
+
+private:
+    detail::buffer<T, N> buffer_;
+    std::size_t first_;
+    std::size_t length_;
+};
+
+/* 
+    `T` 타입의 값을 저장하는 이진 힙 클래스.
+    
+    - `binary_heap.h`와 같이 값을 `ptr[1]`부터 저장하며, 비교 함수 `Compare`의 기준으로 
+      가장 큰 값이 `ptr[1]`에 위치한다.
+*/
+template <typename T, typename Compare = std::less<T>, std::size_t N = ALGOLAB_INLINE_CAPACITY>
+class binary_heap {
+public:
+    using value_type = T;
+    
+    explicit binary_heap(const Compare &compare = Compare(), const Allocator *allocator = nullptr) 
+        : buffer_(allocator), length_(0), compare_(compare) {}
+    
+    binary_heap(binary_heap &&other) noexcept 
+        : buffer_(nullptr), length_(other.length_), compare_(std::move(other.compare_)) {
+        buffer_.steal(other.buffer_, 1, other.length_, 1);
+        
+        other.length_ = 0;
+    }
+    
+    binary_heap &operator=(binary_heap &&other) noexcept {
+        if (this != &other) {
+            clear();
+            
+            buffer_.release();
+            buffer_.steal(other.buffer_, 1, other.length_, 1);
+            
+            length_ = other.length_;
+            compare_ = std::move(other.compare_);
+            
+            other.length_ = 0;
+        }
+        
+        return *this;
+    }
+    
+    binary_heap(const binary_heap &) = delete;
+    
+    binary_heap &operator=(const binary_heap &) = delete;
+    
+    ~binary_heap() { clear(); }
+    
+    /* 이진 힙에 들어 있는 값의 개수를 반환한다. */
+    std::size_t size() const noexcept { return length_; }
+    
+    /* 이진 힙이 비어 있는지 확인한다. */
+    bool empty() const noexcept { return length_ == 0; }
+    
+    /* 이진 힙이 값을 `count`개까지 담을 수 있도록 공간을 확보한다. */
+    bool reserve(std::size_t count) {
+        return (count + 1 <= buffer_.capacity()) || buffer_.relocate(count + 1, 1, length_, 1);
+    }
+    
+    /* 이진 힙이 사용하지 않는 공간을 해제한다. */
+    void shrink_to_fit() {
+        if (length_ + 1 < buffer_.capacity()) buffer_.relocate(length_ + 1, 1, length_, 1);
+    }
+    
+    /* 이진 힙에 들어 있는 모든 값을 제거한다. */
+    void clear() noexcept {
+        T *ptr = buffer_.data();
+        
+        for (std::size_t i = 1; i <= length_; i++)
+            ptr[i].~T();
+        
+        length_ = 0;
+    }
+    
+    /* 이진 힙에 값 `value`를 추가한다. */
+    bool push(const T &value) { return emplace(value); }
+    
+    /* 이진 힙에 값 `value`를 추가한다. */
+    bool push(T &&value) { return emplace(std::move(value)); }
+    
+    /* 이진 힙에 인자 `args`로 생성한 값을 추가한다. */
+    template <typename... Args>
+    bool emplace(Args &&...args) {
+        T value(std::forward<Args>(args)...);
+        
+        // 이진 힙은 `ptr[1]`부터 값을 저장하므로, `ptr[length + 1]`까지 쓸 수 있어야 한다.
+        if (length_ + 1 >= buffer_.capacity() 
+            && !buffer_.relocate(2 * buffer_.capacity(), 1, length_, 1)) return false;
+        
+        T *ptr = buffer_.data();
+        
+        std::size_t i = ++length_;
+        
+        // 이진 힙을 상향식으로 복구한다. 값을 매번 맞바꾸는 대신 빈 자리를 위로 옮긴다.
+        if (i > 1 && STATS_CMP(compare_(ptr[i / 2], value))) {
+            ::new (static_cast<void *>(ptr + i)) T(std::move(ptr[i / 2]));
+            
+            STATS_COUNT(moves);
+            
+            i /= 2;
+            
+            while (i > 1 && STATS_CMP(compare_(ptr[i / 2], value))) {
+                ptr[i] = std::move(ptr[i / 2]);
+                
+                STATS_COUNT(moves);
+                
+                i /= 2;
+            }
+            
+            ptr[i] = std::move(value);
+        } else {
+            ::new (static_cast<void *>(ptr + i)) T(std::move(value));
+        }
+        
+        return true;
+    }
+    
+    /* 이진 힙에서 가장 큰 값을 제거하고, 그 값을 반환한다. 이진 힙은 비어 있으면 안 된다. */
+    T pop() {
+        T *ptr = buffer_.data();
+        
+        T result(std::move(ptr[1]));
+        
+        if (length_ > 1) {
+            T value(std::move(ptr[length_]));
+            
+            ptr[length_--].~T();
+            
+            std::size_t i = 1;
+            
+            // 이진 힙을 하향식으로 복구한다.
+            while (2 * i <= length_) {
+                std::size_t j = 2 * i;
+                
+                if (j + 1 <= length_ && STATS_CMP(compare_(ptr[j], ptr[j + 1]))) j++;
+                
+                // 부모 노드가 자식 노드보다 작지 않으면 복구를 마친다.
+                if (!STATS_CMP(compare_(value, ptr[j]))) break;
+                
+                ptr[i] = std::move(ptr[j]);
+                
+                STATS_COUNT(moves);
+                
+                i = j;
+            }
+            
+            ptr[i] = std::move(value);
+        } else {
+            ptr[length_--].~T();
+        }
+        
+        return result;
+    }
+    
+    /* 이진 힙에서 가장 큰 값을 반환한다. 이진 힙은 비어 있으면 안 된다. */
+    const T &top() const noexcept { return buffer_.data()[1]; }
+
+private:
+    detail::buffer<T, N> buffer_;
+    std::size_t length_;
+    Compare compare_;
+};
+
+/* 삽입 정렬을 나타내는 정렬 엔진. */
+struct insertion_engine {};
+
+/* 셸 정렬을 나타내는 정렬 엔진. */
+struct shell_engine {};
+
+/* 병합 정렬을 나타내는 정렬 엔진. */
+struct merge_engine {};
+
+/* 퀵 정렬을 나타내는 정렬 엔진. */
+struct quick_engine {};
+
+/* 값의 타입과 배열의 길이에 따라 정렬 엔진을 자동으로 고르는 정렬 엔진. */
+struct auto_engine {};
+
+namespace detail {
+
+/* 배열 `ptr[low..high]`를 삽입 정렬한다. */
+template <typename T, typename Compare>
+void insertion_sort(T *ptr, std::size_t low, std::size_t high, std::size_t h, Compare &compare) {
+    for (std::size_t i = low + h; i <= high; i++) {
+        if (!STATS_CMP(compare(ptr[i], ptr[i - h]))) continue;
+        
+        // 값을 매번 맞바꾸는 대신, 빈 자리를 왼쪽으로 옮긴다.
+        T value(std::move(ptr[i]));
+        
+        std::size_t j = i;
+        
+        do {
+            ptr[j] = std::move(ptr[j - h]);
+            
+            STATS_COUNT(moves);
+            
+            j -= h;
+        } while (j >= low + h && STATS_CMP(compare(value, ptr[j - h])));
+        
+        ptr[j] = std::move(value);
+    }
+}
+
+/* 배열 `ptr[0..(count - 1)]`을 셸 정렬한다. */
+template <typename T, typename Compare>
+void shell_sort(T *ptr, std::size_t count, Compare &compare) {
+    std::size_t h = 1;
+    
+    // `sort.h`와 같은 커누스 간격 순열 (1, 4, 13, 40, ...)을 사용한다.
+    while (h < count / 3) h = 3 * h + 1;
+    
+    for (; h >= 1; h /= 3)
+        insertion_sort(ptr, 0, count - 1, h, compare);
+}
+
+/* 배열 `ptr`의 부분 배열 `ptr[low..mid]`과 `ptr[(mid + 1)..high]`를 하나로 합친다. */
+template <typename T, typename Compare>
+void merge_two_arrays(T *ptr, T *aux_ptr, std::size_t low, std::size_t mid, std::size_t high, Compare &compare) {
+    // 두 부분 배열이 이미 순서대로 놓여 있으면 합칠 필요가 없다.
+    if (!STATS_CMP(compare(ptr[mid + 1], ptr[mid]))) return;
+    
+    for (std::size_t k = low; k <= high; k++)
+        ::new (static_cast<void *>(aux_ptr + k)) T(std::move(ptr[k]));
+    
+    STATS_ADD(moves, 2 * (high - low + 1));
+    
+    std::size_t i = low, j = mid + 1;
+    
+    for (std::size_t k = low; k <= high; k++) {
+        if (i <= mid && (j > high || !STATS_CMP(compare(aux_ptr[j], aux_ptr[i])))) ptr[k] = std::move(aux_ptr[i++]);
+        else ptr[k] = std::move(aux_ptr[j++]);
+    }
+    
+    for (std::size_t k = low; k <= high; k++)
+        aux_ptr[k].~T();
+}
+
+/* 배열 `ptr`의 부분 배열 `ptr[low..high]`를 병합 정렬한다. */
+template <typename T, typename Compare>
+void merge_sort(T *ptr, T *aux_ptr, std::size_t low, std::size_t high, Compare &compare) {
+    if (low >= high) return;
+    
+    STATS_ENTER();
+    
+    std::size_t mid = low + (high - low) / 2;
+    
+    merge_sort(ptr, aux_ptr, low, mid, compare);
+    merge_sort(ptr, aux_ptr, mid + 1, high, compare);
+    
+    merge_two_arrays(ptr, aux_ptr, low, mid, high, compare);
+    
+    STATS_LEAVE();
+}
+
+/* 배열 `ptr`의 부분 배열 `ptr[low..high]`를 분할하고, 분할 기준 값의 인덱스를 반환한다. */
+template <typename T, typename Compare>
+std::size_t quick_sort_partition(T *ptr, std::size_t low, std::size_t high, Compare &compare) {
+    using std::swap;
+    
+    // 세 값의 중앙값을 분할 기준으로 삼아, 이미 정렬된 배열에서도 분할이 한쪽으로 치우치지 않게 한다.
+    std::size_t mid = low + (high - low) / 2;
+    
+    if (STATS_CMP(compare(ptr[mid], ptr[low]))) swap(ptr[mid], ptr[low]);
+    if (STATS_CMP(compare(ptr[high], ptr[mid]))) swap(ptr[high], ptr[mid]);
+    if (STATS_CMP(compare(ptr[mid], ptr[low]))) swap(ptr[mid], ptr[low]);
+    
+    swap(ptr[low], ptr[mid]);
+    
+    std::size_t i = low, j = high + 1;
+    
+    for (;;) {
+        while (STATS_CMP(compare(ptr[++i], ptr[low])))
+            if (i == high) break;
+        
+        while (STATS_CMP(compare(ptr[low], ptr[--j])))
+            if (j == low) break;
+        
+        if (i >= j) break;
+        
+        STATS_COUNT(swaps);
+        
+        swap(ptr[i], ptr[j]);
+    }
+    
+    STATS_COUNT(swaps);
+    
+    swap(ptr[low], ptr[j]);
+    
+    return j;
+}
+
+/* 배열 `ptr`의 부분 배열 `ptr[low..high]`를 퀵 정렬한다. */
+template <typename T, typename Compare>
+void quick_sort(T *ptr, std::size_t low, std::size_t high, Compare &compare) {
+    STATS_ENTER();
+    
+    // 더 짧은 쪽만 재귀적으로 정렬하여, 재귀 호출의 깊이를 `O(log(N))`으로 제한한다.
+    while (low < high) {
+        std::size_t mid = quick_sort_partition(ptr, low, high, compare);
+        
+        if (mid - low < high - mid) {
+            if (mid > low) quick_sort(ptr, low, mid - 1, compare);
+            
+            low = mid + 1;
+        } else {
+            quick_sort(ptr, mid + 1, high, compare);
+            
+            if (mid == low) break;
+            
+            high = mid - 1;
+        }
+    }
+    
+    STATS_LEAVE();
+}
+
+/* 값의 타입 `T`와 배열의 길이 `SizeHint`에 맞는 정렬 엔진을 고른다. */
+template <typename T, std::size_t SizeHint>
+struct select_engine {
+    /*
+        - 짧은 배열은 삽입 정렬이 가장 빠르다.
+        - 복사가 간단하고 크기가 작은 값은 추가 메모리 없이 제자리에서 정렬하는 퀵 정렬을 사용한다.
+        - 그 밖의 값은 비교 횟수가 더 적은 병합 정렬을 사용한다.
+    */
+    using type = std::conditional_t<
+        (SizeHint <= ALGOLAB_SMALL_SORT_THRESHOLD), 
+        insertion_engine,
+        std::conditional_t<
+            (std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void *)),
+            quick_engine,
+            merge_engine
+        >
+    >;
+};
+
+}
+
+/* 
+    배열 `values`를 비교 함수 `compare`의 기준으로 정렬 엔진 `Engine`을 사용하여 정렬한다.
+    
+    - `Engine`이 `auto_engine`이면, 값의 타입과 배열의 길이 `SizeHint`에 맞는 정렬 엔진을 
+      컴파일 시간에 고른다. `SizeHint`를 알 수 없으면 짧은 배열만 실행 시간에 따로 처리한다.
+    - `merge_engine`이 보조 배열을 할당하지 못하면 셸 정렬을 대신 사용한다.
+*/
+template <typename Engine = auto_engine, std::size_t SizeHint = dynamic_extent, typename T, typename Compare = std::less<T>>
+void sort(span<T> values, Compare compare = Compare()) {
+    T *ptr = values.data();
+    
+    std::size_t count = values.size();
+    
+    if (ptr == nullptr || count <= 1) return;
+    
+    if constexpr (std::is_same_v<Engine, auto_engine>) {
+        using engine = typename detail::select_engine<T, SizeHint>::type;
+        
+        if constexpr (SizeHint == dynamic_extent) {
+            if (count <= ALGOLAB_SMALL_SORT_THRESHOLD) {
+                sort<insertion_engine>(values, compare);
+                
+                return;
+            }
+        }
+        
+        sort<engine>(values, compare);
+    } else if constexpr (std::is_same_v<Engine, insertion_engine>) {
+        detail::insertion_sort(ptr, 0, count - 1, 1, compare);
+    } else if constexpr (std::is_same_v<Engine, shell_engine>) {
+        detail::shell_sort(ptr, count, compare);
+    } else if constexpr (std::is_same_v<Engine, merge_engine>) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+        
+        T *aux_ptr = static_cast<T *>(allocator_alloc(nullptr, count * sizeof(T)));
+        
+        if (aux_ptr == nullptr) {
+            detail::shell_sort(ptr, count, compare);
+            
+            return;
+        }
+        
+        detail::merge_sort(ptr, aux_ptr, 0, count - 1, compare);
+        
+        allocator_free(nullptr, aux_ptr, count * sizeof(T));
+    } else if constexpr (std::is_same_v<Engine, quick_engine>) {
+        detail::quick_sort(ptr, 0, count - 1, compare);
+    } else {
+        static_assert(!std::is_same_v<Engine, Engine>, "unknown sort engine");
+    }
+}
+
+}
+
+#endif // `ALGOLAB_HPP`
\ No newline at end of file
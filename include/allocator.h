@@ -0,0 +1,476 @@
+/*
+    Copyright (c) 2021 jdeokkim
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 가상 메모리 공간을 예약하고 필요할 때마다 페이지를 확정할 수 있는지 여부. */
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/mman.h>
+    #include <unistd.h>
+    
+    #if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+        #define MAP_ANONYMOUS MAP_ANON
+    #endif
+    
+    #ifndef MAP_NORESERVE
+        #define MAP_NORESERVE 0
+    #endif
+#endif
+
+#if defined(MAP_ANONYMOUS)
+    #define ALLOCATOR_HAS_VM 1
+#else
+    #define ALLOCATOR_HAS_VM 0
+#endif
+
+#include "stats.h"
+
+#define ALLOCATOR_DEF static
+
+/* 아레나 할당자의 기본 블록 크기. */
+#define ARENA_DEFAULT_BLOCK_SIZE 65536
+
+/* 아레나 할당자가 반환하는 메모리 주소의 정렬 단위. */
+#define ARENA_ALIGNMENT 16
+
+/* 풀 할당자의 가장 작은 슬롯 크기. */
+#define POOL_MIN_SLOT_SIZE 16
+
+/* 풀 할당자의 슬롯 크기 종류의 개수 (`16`, `32`, ..., `512`). */
+#define POOL_SIZE_CLASS_COUNT 6
+
+/* 풀 할당자가 한 번에 확보하는 메모리 덩어리의 크기. */
+#define POOL_CHUNK_SIZE 65536
+
+/* 
+    메모리 할당자를 나타내는 구조체.
+    
+    - `alloc`은 0으로 초기화된 메모리를 반환해야 한다.
+    - `realloc`과 `free`에는 기존에 할당한 메모리의 크기가 함께 전달된다.
+    - 모든 함수 포인터가 `NULL`이면 `calloc()`, `realloc()`과 `free()`를 사용한다.
+*/
+typedef struct Allocator {
+    void *ctx;
+    void *(*alloc)(void *ctx, size_t size);
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    void (*free)(void *ctx, void *ptr, size_t size);
+} Allocator;
+
+/* 아레나 할당자의 메모리 블록을 나타내는 구조체. */
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t capacity;
+    size_t offset;
+} ArenaBlock;
+
+/* 아레나 할당자를 나타내는 구조체. */
+typedef struct Arena {
+    size_t block_size;
+    ArenaBlock *head;
+} Arena;
+
+/* 풀 할당자의 빈 슬롯을 나타내는 구조체. */
+typedef struct PoolSlot {
+    struct PoolSlot *next;
+} PoolSlot;
+
+/* 풀 할당자를 나타내는 구조체. */
+typedef struct Pool {
+    PoolSlot *free_lists[POOL_SIZE_CLASS_COUNT];
+    void *chunks;
+} Pool;
+
+/* 할당자 `allocator`로 `size` 바이트 크기의 메모리를 할당한다. */
+static inline void *allocator_alloc(const Allocator *allocator, size_t size) {
+    STATS_COUNT(allocations);
+    
+    if (allocator == NULL || allocator->alloc == NULL) return calloc(1, size);
+    
+    return allocator->alloc(allocator->ctx, size);
+}
+
+/* 할당자 `allocator`로 할당한 메모리 `ptr`의 크기를 `old_size`에서 `new_size`로 바꾼다. */
+static inline void *allocator_realloc(const Allocator *allocator, void *ptr, size_t old_size, size_t new_size) {
+    STATS_COUNT(reallocations);
+    
+    if (allocator == NULL || allocator->realloc == NULL) return realloc(ptr, new_size);
+    
+    return allocator->realloc(allocator->ctx, ptr, old_size, new_size);
+}
+
+/* 할당자 `allocator`로 할당한 `size` 바이트 크기의 메모리 `ptr`을 해제한다. */
+static inline void allocator_free(const Allocator *allocator, void *ptr, size_t size) {
+    if (ptr == NULL) return;
+    
+    if (allocator == NULL || allocator->free == NULL) free(ptr);
+    else allocator->free(allocator->ctx, ptr, size);
+}
+
+/* 가상 메모리 페이지의 크기를 반환한다. */
+static inline size_t vm_page_size(void) {
+#if ALLOCATOR_HAS_VM
+    static size_t result = 0;
+    
+    if (result == 0) result = (size_t) sysconf(_SC_PAGESIZE);
+    
+    return result;
+#else
+    return 4096;
+#endif
+}
+
+/* `size`를 가상 메모리 페이지 크기의 배수로 올림한다. */
+static inline size_t vm_round(size_t size) {
+    size_t page_size = vm_page_size();
+    
+    return ((size + page_size - 1) / page_size) * page_size;
+}
+
+/* 접근할 수 없는 `size` 바이트 크기의 가상 메모리 공간을 예약한다. */
+static inline void *vm_reserve(size_t size) {
+#if ALLOCATOR_HAS_VM
+    void *result = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    
+    return (result != MAP_FAILED) ? result : NULL;
+#else
+    (void) size;
+    
+    return NULL;
+#endif
+}
+
+/* 예약한 가상 메모리 공간 `ptr`의 `size` 바이트를 읽고 쓸 수 있도록 확정한다. */
+static inline bool vm_commit(void *ptr, size_t size) {
+#if ALLOCATOR_HAS_VM
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#else
+    (void) ptr, (void) size;
+    
+    return false;
+#endif
+}
+
+/* 확정한 가상 메모리 공간 `ptr`의 `size` 바이트를 운영체제에 돌려주고, 다시 예약 상태로 만든다. */
+static inline void vm_decommit(void *ptr, size_t size) {
+#if ALLOCATOR_HAS_VM
+    // 같은 위치에 새로운 공간을 덮어씌워서, 확정했던 페이지를 운영체제에 돌려준다.
+    mmap(ptr, size, PROT_NONE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+#else
+    (void) ptr, (void) size;
+#endif
+}
+
+/* 예약한 `size` 바이트 크기의 가상 메모리 공간 `ptr`을 해제한다. */
+static inline void vm_release(void *ptr, size_t size) {
+#if ALLOCATOR_HAS_VM
+    if (ptr != NULL) munmap(ptr, size);
+#else
+    (void) ptr, (void) size;
+#endif
+}
+
+/* 가상 메모리 공간 `ptr`의 `size` 바이트에 투명한 거대 페이지 (THP)를 사용하도록 권고한다. */
+static inline void vm_advise_huge_pages(void *ptr, size_t size) {
+#if ALLOCATOR_HAS_VM && defined(MADV_HUGEPAGE)
+    madvise(ptr, size, MADV_HUGEPAGE);
+#else
+    (void) ptr, (void) size;
+#endif
+}
+
+/* 블록 크기가 `block_size`인 아레나 할당자를 생성한다. */
+ALLOCATOR_DEF Arena *arena_create(size_t block_size);
+
+/* 아레나 할당자 `arena`에 할당된 메모리를 해제한다. */
+ALLOCATOR_DEF void arena_release(Arena *arena);
+
+/* 아레나 할당자 `arena`로 할당한 모든 메모리를 한 번에 해제한다. */
+ALLOCATOR_DEF void arena_reset(Arena *arena);
+
+/* 아레나 할당자 `arena`를 사용하는 메모리 할당자를 반환한다. */
+ALLOCATOR_DEF Allocator arena_allocator(Arena *arena);
+
+/* 현재 스레드의 풀 할당자를 사용하는 메모리 할당자를 반환한다. */
+ALLOCATOR_DEF Allocator pool_allocator_local(void);
+
+/* 현재 스레드의 풀 할당자가 확보한 모든 메모리를 해제한다. */
+ALLOCATOR_DEF void pool_release_local(void);
+
+#endif // `ALLOCATOR_H`
+
+/* 다른 헤더 파일을 통해 여러 번 포함되더라도 구현 부분은 한 번만 정의한다. */
+#if defined(ALLOCATOR_IMPLEMENTATION) && !defined(ALLOCATOR_IMPLEMENTATION_ONCE)
+#define ALLOCATOR_IMPLEMENTATION_ONCE
+
+/* 현재 스레드의 풀 할당자. */
+static ALGOLAB_THREAD_LOCAL Pool _pool_local;
+
+/* `size`를 `ARENA_ALIGNMENT`의 배수로 올림한다. */
+ALLOCATOR_DEF size_t _arena_align(size_t size) {
+    return (size + (ARENA_ALIGNMENT - 1)) & ~((size_t) ARENA_ALIGNMENT - 1);
+}
+
+/* 아레나 할당자의 메모리 블록 `block`의 데이터 영역을 반환한다. */
+ALLOCATOR_DEF unsigned char *_arena_block_data(ArenaBlock *block) {
+    return (unsigned char *) block + _arena_align(sizeof(ArenaBlock));
+}
+
+/* 아레나 할당자 `ctx`로 `size` 바이트 크기의 메모리를 할당한다. */
+ALLOCATOR_DEF void *_arena_alloc(void *ctx, size_t size) {
+    Arena *arena = (Arena *) ctx;
+    
+    size = _arena_align(size);
+    
+    ArenaBlock *head = arena->head;
+    
+    // 현재 블록에 남은 공간이 부족하면, 새로운 블록을 만든다.
+    if (head == NULL || head->offset + size > head->capacity) {
+        size_t capacity = (size > arena->block_size) ? size : arena->block_size;
+        
+        ArenaBlock *block = (ArenaBlock *) malloc(_arena_align(sizeof(ArenaBlock)) + capacity);
+        
+        if (block == NULL) return NULL;
+        
+        block->next = head;
+        block->capacity = capacity;
+        block->offset = 0;
+        
+        arena->head = head = block;
+    }
+    
+    void *result = _arena_block_data(head) + head->offset;
+    
+    head->offset += size;
+    
+    return memset(result, 0, size);
+}
+
+/* 아레나 할당자 `ctx`로 할당한 메모리 `ptr`의 크기를 `old_size`에서 `new_size`로 바꾼다. */
+ALLOCATOR_DEF void *_arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    Arena *arena = (Arena *) ctx;
+    
+    ArenaBlock *head = arena->head;
+    
+    if (ptr == NULL) return _arena_alloc(ctx, new_size);
+    
+    old_size = _arena_align(old_size);
+    new_size = _arena_align(new_size);
+    
+    // 가장 마지막에 할당한 메모리라면, 복사하지 않고 그 자리에서 크기를 바꾼다.
+    if (head != NULL && (unsigned char *) ptr + old_size == _arena_block_data(head) + head->offset
+        && head->offset - old_size + new_size <= head->capacity) {
+        head->offset = head->offset - old_size + new_size;
+        
+        return ptr;
+    }
+    
+    void *result = _arena_alloc(ctx, new_size);
+    
+    if (result != NULL) memcpy(result, ptr, (old_size < new_size) ? old_size : new_size);
+    
+    return result;
+}
+
+/* 아레나 할당자 `ctx`로 할당한 `size` 바이트 크기의 메모리 `ptr`을 해제한다. */
+ALLOCATOR_DEF void _arena_free(void *ctx, void *ptr, size_t size) {
+    Arena *arena = (Arena *) ctx;
+    
+    ArenaBlock *head = arena->head;
+    
+    size = _arena_align(size);
+    
+    // 가장 마지막에 할당한 메모리만 되돌려 받고, 나머지는 `arena_reset()`에서 한 번에 해제한다.
+    if (head != NULL && (unsigned char *) ptr + size == _arena_block_data(head) + head->offset)
+        head->offset -= size;
+}
+
+/* 블록 크기가 `block_size`인 아레나 할당자를 생성한다. */
+ALLOCATOR_DEF Arena *arena_create(size_t block_size) {
+    Arena *result = (Arena *) calloc(1, sizeof(Arena));
+    
+    result->block_size = (block_size > 0) ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+    
+    return result;
+}
+
+/* 아레나 할당자 `arena`에 할당된 메모리를 해제한다. */
+ALLOCATOR_DEF void arena_release(Arena *arena) {
+    if (arena == NULL) return;
+    
+    ArenaBlock *block = arena->head;
+    
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        
+        free(block);
+        block = next;
+    }
+    
+    free(arena);
+}
+
+/* 아레나 할당자 `arena`로 할당한 모든 메모리를 한 번에 해제한다. */
+ALLOCATOR_DEF void arena_reset(Arena *arena) {
+    if (arena == NULL || arena->head == NULL) return;
+    
+    // 가장 최근에 만든 블록 하나만 남겨 두고 재사용한다.
+    ArenaBlock *block = arena->head->next;
+    
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        
+        free(block);
+        block = next;
+    }
+    
+    arena->head->next = NULL;
+    arena->head->offset = 0;
+}
+
+/* 아레나 할당자 `arena`를 사용하는 메모리 할당자를 반환한다. */
+ALLOCATOR_DEF Allocator arena_allocator(Arena *arena) {
+    Allocator result = { arena, _arena_alloc, _arena_realloc, _arena_free };
+    
+    return result;
+}
+
+/* `size` 바이트 크기의 메모리를 담을 수 있는 풀 할당자의 슬롯 크기 종류를 반환한다. */
+ALLOCATOR_DEF int _pool_size_class(size_t size) {
+    int result = 0;
+    
+    for (size_t slot_size = POOL_MIN_SLOT_SIZE; slot_size < size; slot_size *= 2)
+        result++;
+    
+    return result;
+}
+
+/* 풀 할당자 `ctx`로 `size` 바이트 크기의 메모리를 할당한다. */
+ALLOCATOR_DEF void *_pool_alloc(void *ctx, size_t size) {
+    Pool *pool = (Pool *) ctx;
+    
+    int size_class = _pool_size_class(size);
+    
+    // 슬롯에 담을 수 없을 만큼 큰 메모리는 `calloc()`으로 할당한다.
+    if (size_class >= POOL_SIZE_CLASS_COUNT) return calloc(1, size);
+    
+    size_t slot_size = (size_t) POOL_MIN_SLOT_SIZE << size_class;
+    
+    // 빈 슬롯이 없으면, 메모리 덩어리를 새로 확보하여 같은 크기의 슬롯으로 나눈다.
+    if (pool->free_lists[size_class] == NULL) {
+        unsigned char *chunk = (unsigned char *) malloc(POOL_CHUNK_SIZE);
+        
+        if (chunk == NULL) return NULL;
+        
+        *(void **) chunk = pool->chunks;
+        pool->chunks = chunk;
+        
+        for (size_t offset = slot_size; offset + slot_size <= POOL_CHUNK_SIZE; offset += slot_size) {
+            PoolSlot *slot = (PoolSlot *) (chunk + offset);
+            
+            slot->next = pool->free_lists[size_class];
+            pool->free_lists[size_class] = slot;
+        }
+    }
+    
+    PoolSlot *result = pool->free_lists[size_class];
+    
+    pool->free_lists[size_class] = result->next;
+    
+    return memset(result, 0, slot_size);
+}
+
+/* 풀 할당자 `ctx`로 할당한 `size` 바이트 크기의 메모리 `ptr`을 해제한다. */
+ALLOCATOR_DEF void _pool_free(void *ctx, void *ptr, size_t size) {
+    Pool *pool = (Pool *) ctx;
+    
+    int size_class = _pool_size_class(size);
+    
+    if (size_class >= POOL_SIZE_CLASS_COUNT) {
+        free(ptr);
+    } else {
+        PoolSlot *slot = (PoolSlot *) ptr;
+        
+        slot->next = pool->free_lists[size_class];
+        pool->free_lists[size_class] = slot;
+    }
+}
+
+/* 풀 할당자 `ctx`로 할당한 메모리 `ptr`의 크기를 `old_size`에서 `new_size`로 바꾼다. */
+ALLOCATOR_DEF void *_pool_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL) return _pool_alloc(ctx, new_size);
+    
+    int old_class = _pool_size_class(old_size);
+    int new_class = _pool_size_class(new_size);
+    
+    // 슬롯 크기가 바뀌지 않으면 그대로 사용하고, 둘 다 슬롯보다 크면 `realloc()`을 사용한다.
+    if (old_class == new_class && old_class < POOL_SIZE_CLASS_COUNT) return ptr;
+    
+    if (old_class >= POOL_SIZE_CLASS_COUNT && new_class >= POOL_SIZE_CLASS_COUNT)
+        return realloc(ptr, new_size);
+    
+    void *result = _pool_alloc(ctx, new_size);
+    
+    if (result != NULL) {
+        memcpy(result, ptr, (old_size < new_size) ? old_size : new_size);
+        
+        _pool_free(ctx, ptr, old_size);
+    }
+    
+    return result;
+}
+
+/* 현재 스레드의 풀 할당자를 사용하는 메모리 할당자를 반환한다. */
+ALLOCATOR_DEF Allocator pool_allocator_local(void) {
+    /*
+        풀 할당자는 스레드마다 따로 존재하므로 잠금 없이 동작한다. 대신에 이 할당자로 
+        만든 자료 구조는 할당자를 반환받은 스레드에서만 사용하고 해제해야 한다.
+    */
+    
+    Allocator result = { &_pool_local, _pool_alloc, _pool_realloc, _pool_free };
+    
+    return result;
+}
+
+/* 현재 스레드의 풀 할당자가 확보한 모든 메모리를 해제한다. */
+ALLOCATOR_DEF void pool_release_local(void) {
+    void *chunk = _pool_local.chunks;
+    
+    while (chunk != NULL) {
+        void *next = *(void **) chunk;
+        
+        free(chunk);
+        chunk = next;
+    }
+    
+    memset(&_pool_local, 0, sizeof(Pool));
+}
+
+#endif // `ALLOCATOR_IMPLEMENTATION`
\ No newline at end of file
@@ -26,22 +26,66 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "stats.h"
+#include "trace.h"
 
 #define BINARY_HEAP_DEF static
 
+/* 이진 힙 구조체 안에 직접 저장할 수 있는 값의 최대 개수. */
+#ifndef BINARY_HEAP_INLINE_CAPACITY
+    #define BINARY_HEAP_INLINE_CAPACITY 8
+#endif
+
 /* 이진 힙을 나타내는 구조체. */
 typedef struct BinaryHeap {
     int length;
     int capacity;
+    int reserved;
     unsigned int *ptr;
+    Allocator allocator;
+    unsigned int inline_ptr[BINARY_HEAP_INLINE_CAPACITY];
 } BinaryHeap;
 
 /* 이진 힙을 생성한다. */
 BINARY_HEAP_DEF BinaryHeap *binary_heap_create(void);
 
+/* 메모리 할당자 `allocator`를 사용하는 이진 힙을 생성한다. */
+BINARY_HEAP_DEF BinaryHeap *binary_heap_create_with_allocator(const Allocator *allocator);
+
+/* 
+    값을 최대 `max_count`개까지 담을 수 있는 가상 메모리 공간을 미리 예약해 둔 이진 힙을 생성한다.
+    
+    - 이진 힙의 크기가 커지면 예약한 공간의 페이지를 필요한 만큼만 확정하므로, 
+      값을 복사하지 않고 각 값의 주소도 바뀌지 않는다.
+    - `huge_pages`가 `true`이면 투명한 거대 페이지 (THP)를 사용하도록 권고한다.
+    - 가상 메모리를 예약할 수 없으면 `binary_heap_create()`와 같이 동작한다.
+*/
+BINARY_HEAP_DEF BinaryHeap *binary_heap_create_reserved(int max_count, bool huge_pages);
+
 /* 이진 힙 `heap`에 할당된 메모리를 해제한다. */
 BINARY_HEAP_DEF void binary_heap_release(BinaryHeap *heap);
 
+/* 
+    이진 힙 `heap`을 초기화한다.
+    
+    - 값이 `BINARY_HEAP_INLINE_CAPACITY - 1`개를 넘기 전까지는 구조체 안의 내장 버퍼를 사용하므로,
+      지역 변수로 선언한 이진 힙도 메모리를 할당하지 않고 사용할 수 있다.
+    - 구조체가 내장 버퍼의 주소를 가지고 있으므로, 초기화한 이진 힙을 값으로 복사해서는 안 된다.
+*/
+BINARY_HEAP_DEF void binary_heap_init(BinaryHeap *heap);
+
+/* `binary_heap_init()`으로 초기화한 이진 힙 `heap`이 내장 버퍼 밖에 할당한 메모리를 해제한다. */
+BINARY_HEAP_DEF void binary_heap_deinit(BinaryHeap *heap);
+
+/* 이진 힙 `heap`이 값을 `count`개까지 담을 수 있도록 공간을 확보한다. */
+BINARY_HEAP_DEF bool binary_heap_reserve(BinaryHeap *heap, int count);
+
+/* 이진 힙 `heap`이 사용하지 않는 공간을 해제한다. */
+BINARY_HEAP_DEF void binary_heap_shrink_to_fit(BinaryHeap *heap);
+
 /* 이진 힙 `heap`에 들어 있는 모든 값을 제거한다. */
 BINARY_HEAP_DEF void binary_heap_clear(BinaryHeap *heap);
 
@@ -59,22 +103,177 @@ BINARY_HEAP_DEF int binary_heap_pop(BinaryHeap *heap);
 
 #endif // `BINARY_HEAP_H`
 
-#ifdef BINARY_HEAP_IMPLEMENTATION
+/* 다른 헤더 파일을 통해 여러 번 포함되더라도 구현 부분은 한 번만 정의한다. */
+#if defined(BINARY_HEAP_IMPLEMENTATION) && !defined(BINARY_HEAP_IMPLEMENTATION_ONCE)
+#define BINARY_HEAP_IMPLEMENTATION_ONCE
 
 /* 이진 힙을 생성한다. */
 BINARY_HEAP_DEF BinaryHeap *binary_heap_create(void) {
-    BinaryHeap *result = calloc(1, sizeof(BinaryHeap));
+    return binary_heap_create_with_allocator(NULL);
+}
+
+/* 메모리 할당자 `allocator`를 사용하는 이진 힙을 생성한다. */
+BINARY_HEAP_DEF BinaryHeap *binary_heap_create_with_allocator(const Allocator *allocator) {
+    BinaryHeap *result = allocator_alloc(allocator, sizeof(BinaryHeap));
+    
+    if (result == NULL) return NULL;
     
-    result->capacity = 8;
-    result->ptr = calloc(result->capacity, sizeof(unsigned int));
+    binary_heap_init(result);
+    
+    if (allocator != NULL) result->allocator = *allocator;
+    
+    return result;
+}
+
+/* 값을 최대 `max_count`개까지 담을 수 있는 가상 메모리 공간을 미리 예약해 둔 이진 힙을 생성한다. */
+BINARY_HEAP_DEF BinaryHeap *binary_heap_create_reserved(int max_count, bool huge_pages) {
+    if (max_count <= 0) return NULL;
+    
+    // 이진 힙은 `ptr[1]`부터 값을 저장하므로, 한 칸을 더 예약한다.
+    size_t size = vm_round(((size_t) max_count + 1) * sizeof(unsigned int));
+    
+    void *ptr = vm_reserve(size);
+    
+    if (ptr == NULL) return binary_heap_create();
+    
+    if (huge_pages) vm_advise_huge_pages(ptr, size);
+    
+    if (!vm_commit(ptr, vm_page_size())) {
+        vm_release(ptr, size);
+        
+        return binary_heap_create();
+    }
+    
+    BinaryHeap *result = allocator_alloc(NULL, sizeof(BinaryHeap));
+    
+    if (result == NULL) {
+        vm_release(ptr, size);
+        
+        return NULL;
+    }
+    
+    result->capacity = vm_page_size() / sizeof(unsigned int);
+    result->reserved = size / sizeof(unsigned int);
+    result->ptr = ptr;
     
     return result;
 }
 
 /* 이진 힙 `heap`에 할당된 메모리를 해제한다. */
 BINARY_HEAP_DEF void binary_heap_release(BinaryHeap *heap) {
-    free(heap->ptr);
-    free(heap);
+    if (heap == NULL) return;
+    
+    binary_heap_deinit(heap);
+    
+    Allocator allocator = heap->allocator;
+    
+    allocator_free(&allocator, heap, sizeof(BinaryHeap));
+}
+
+/* 이진 힙 `heap`을 초기화한다. */
+BINARY_HEAP_DEF void binary_heap_init(BinaryHeap *heap) {
+    if (heap == NULL) return;
+    
+    memset(heap, 0, sizeof(BinaryHeap));
+    
+    heap->capacity = BINARY_HEAP_INLINE_CAPACITY;
+    heap->ptr = heap->inline_ptr;
+}
+
+/* `binary_heap_init()`으로 초기화한 이진 힙 `heap`이 내장 버퍼 밖에 할당한 메모리를 해제한다. */
+BINARY_HEAP_DEF void binary_heap_deinit(BinaryHeap *heap) {
+    if (heap == NULL) return;
+    
+    if (heap->reserved > 0) 
+        vm_release(heap->ptr, heap->reserved * sizeof(unsigned int));
+    else if (heap->ptr != heap->inline_ptr) 
+        allocator_free(&heap->allocator, heap->ptr, heap->capacity * sizeof(unsigned int));
+    
+    heap->length = 0;
+    heap->capacity = BINARY_HEAP_INLINE_CAPACITY;
+    heap->reserved = 0;
+    heap->ptr = heap->inline_ptr;
+}
+
+/* 이진 힙 `heap`의 버퍼 크기를 `capacity`로 바꾼다. */
+BINARY_HEAP_DEF bool _binary_heap_resize_buffer(BinaryHeap *heap, int capacity) {
+    if (heap->reserved > 0) {
+        // 예약한 공간의 페이지를 확정하거나 되돌려 준다.
+        size_t old_size = heap->capacity * sizeof(unsigned int);
+        size_t new_size = vm_round(capacity * sizeof(unsigned int));
+        
+        if (new_size > heap->reserved * sizeof(unsigned int)) return false;
+        
+        unsigned char *ptr = (unsigned char *) heap->ptr;
+        
+        if (new_size > old_size && !vm_commit(ptr + old_size, new_size - old_size)) return false;
+        if (new_size < old_size) vm_decommit(ptr + new_size, old_size - new_size);
+        
+        heap->capacity = new_size / sizeof(unsigned int);
+    } else if (capacity <= BINARY_HEAP_INLINE_CAPACITY) {
+        // 값을 다시 내장 버퍼로 옮기고, 내장 버퍼 밖에 할당한 메모리를 해제한다.
+        if (heap->ptr != heap->inline_ptr) {
+            memcpy(heap->inline_ptr, heap->ptr, (heap->length + 1) * sizeof(unsigned int));
+            
+            allocator_free(&heap->allocator, heap->ptr, heap->capacity * sizeof(unsigned int));
+        }
+        
+        heap->ptr = heap->inline_ptr;
+        heap->capacity = BINARY_HEAP_INLINE_CAPACITY;
+    } else if (heap->ptr == heap->inline_ptr) {
+        // 내장 버퍼가 가득 차면, 값을 새로 할당한 메모리로 옮긴다.
+        unsigned int *ptr = allocator_alloc(&heap->allocator, capacity * sizeof(unsigned int));
+        
+        if (ptr == NULL) return false;
+        
+        memcpy(ptr, heap->inline_ptr, (heap->length + 1) * sizeof(unsigned int));
+        
+        heap->ptr = ptr;
+        heap->capacity = capacity;
+    } else {
+        unsigned int *ptr = allocator_realloc(
+            &heap->allocator, 
+            heap->ptr, 
+            heap->capacity * sizeof(unsigned int), 
+            capacity * sizeof(unsigned int)
+        );
+        
+        if (ptr == NULL) return false;
+        
+        heap->ptr = ptr;
+        heap->capacity = capacity;
+    }
+    
+    return true;
+}
+
+/* 이진 힙 `heap`의 용량을 `capacity`로 바꾼다. */
+BINARY_HEAP_DEF bool _binary_heap_resize(BinaryHeap *heap, int capacity) {
+    TRACE_BEGIN(resize);
+    
+    bool result = _binary_heap_resize_buffer(heap, capacity);
+    
+    TRACE_END(resize, "binary_heap_resize");
+    
+    return result;
+}
+
+/* 이진 힙 `heap`이 값을 `count`개까지 담을 수 있도록 공간을 확보한다. */
+BINARY_HEAP_DEF bool binary_heap_reserve(BinaryHeap *heap, int count) {
+    if (heap == NULL) return false;
+    
+    return (count + 1 <= heap->capacity) || _binary_heap_resize(heap, count + 1);
+}
+
+/* 이진 힙 `heap`이 사용하지 않는 공간을 해제한다. */
+BINARY_HEAP_DEF void binary_heap_shrink_to_fit(BinaryHeap *heap) {
+    if (heap == NULL) return;
+    
+    int capacity = (heap->length + 1 > BINARY_HEAP_INLINE_CAPACITY) 
+        ? heap->length + 1 
+        : BINARY_HEAP_INLINE_CAPACITY;
+    
+    if (capacity < heap->capacity) _binary_heap_resize(heap, capacity);
 }
 
 /* 이진 힙 `heap`에 들어 있는 모든 값을 제거한다. */
@@ -96,9 +295,14 @@ BINARY_HEAP_DEF bool binary_heap_is_empty(BinaryHeap *heap) {
 BINARY_HEAP_DEF void binary_heap_push(BinaryHeap *heap, unsigned int value) {
     if (heap == NULL) return;
     
-    if (heap->length >= heap->capacity) {
-        heap->capacity *= 2;
-        heap->ptr = realloc(heap->ptr, heap->capacity * sizeof(unsigned int));
+    // 이진 힙은 `ptr[1]`부터 값을 저장하므로, `ptr[length + 1]`까지 쓸 수 있어야 한다.
+    if (heap->length + 1 >= heap->capacity) {
+        int capacity = 2 * heap->capacity;
+        
+        // 예약한 공간이 부족하면 남은 공간까지만 확정하고, 남은 공간이 없으면 값을 추가하지 않는다.
+        if (heap->reserved > 0 && capacity > heap->reserved) capacity = heap->reserved;
+        
+        if (capacity <= heap->capacity || !_binary_heap_resize(heap, capacity)) return;
     }
     
     heap->ptr[++heap->length] = value;
@@ -106,7 +310,9 @@ BINARY_HEAP_DEF void binary_heap_push(BinaryHeap *heap, unsigned int value) {
     int i = heap->length;
     
     // 이진 힙을 상향식으로 복구한다.
-    while (i > 1 && heap->ptr[i] > heap->ptr[i / 2]) {
+    while (i > 1 && STATS_CMP(heap->ptr[i] > heap->ptr[i / 2])) {
+        STATS_COUNT(swaps);
+        
         int temp_value = heap->ptr[i];
         
         heap->ptr[i] = heap->ptr[i / 2];
@@ -131,10 +337,12 @@ BINARY_HEAP_DEF int binary_heap_pop(BinaryHeap *heap) {
     while (2 * i <= heap->length) {
         int j = 2 * i;
         
-        if (heap->ptr[j] < heap->ptr[j + 1] && j + 1 <= heap->length) j++;
+        if (STATS_CMP(heap->ptr[j] < heap->ptr[j + 1]) && j + 1 <= heap->length) j++;
         
         // 부모 노드가 자식 노드보다 크면 복구를 마친다.
-        if (heap->ptr[i] > heap->ptr[j]) break;
+        if (STATS_CMP(heap->ptr[i] > heap->ptr[j])) break;
+        
+        STATS_COUNT(swaps);
         
         int temp_value = heap->ptr[i];
         
@@ -0,0 +1,1010 @@
+/*
+    Copyright (c) 2021 jdeokkim
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "stats.h"
+
+#define BPLUS_TREE_DEF static
+
+/* B+ 트리의 각 노드의 크기 (바이트). 캐시 라인 크기의 배수로 정하는 것이 좋다. */
+#ifndef BPLUS_TREE_NODE_SIZE
+    #define BPLUS_TREE_NODE_SIZE 512
+#endif
+
+/* B+ 트리의 리프 노드에 들어갈 수 있는 키의 최대 개수. */
+#define BPLUS_TREE_LEAF_CAPACITY \
+    ((int) ((BPLUS_TREE_NODE_SIZE - sizeof(BPlusTreeNode) - 2 * sizeof(void *)) / sizeof(int)))
+
+/* B+ 트리의 내부 노드에 들어갈 수 있는 자식 노드의 최대 개수. */
+#define BPLUS_TREE_INTERNAL_CAPACITY \
+    ((int) ((BPLUS_TREE_NODE_SIZE - sizeof(BPlusTreeNode)) / (2 * sizeof(int) + sizeof(void *))))
+
+/* B+ 트리의 노드가 공통으로 가지는 정보를 나타내는 구조체. */
+typedef struct BPlusTreeNode {
+    int count;
+    bool is_leaf;
+} BPlusTreeNode;
+
+/* B+ 트리의 리프 노드를 나타내는 구조체. */
+typedef struct BPlusTreeLeaf {
+    BPlusTreeNode node;
+    struct BPlusTreeLeaf *prev;
+    struct BPlusTreeLeaf *next;
+    int keys[BPLUS_TREE_LEAF_CAPACITY];
+} BPlusTreeLeaf;
+
+/* 
+    B+ 트리의 내부 노드를 나타내는 구조체.
+    
+    - `children[i]`에 들어 있는 키는 모두 `keys[i]` 이상, `keys[i + 1]` 미만이다. (`keys[0]`은 사용하지 않는다.)
+    - `sizes[i]`는 `children[i]`를 루트로 하는 부분 트리에 들어 있는 키의 개수이다.
+*/
+typedef struct BPlusTreeInternal {
+    BPlusTreeNode node;
+    int keys[BPLUS_TREE_INTERNAL_CAPACITY];
+    int sizes[BPLUS_TREE_INTERNAL_CAPACITY];
+    BPlusTreeNode *children[BPLUS_TREE_INTERNAL_CAPACITY];
+} BPlusTreeInternal;
+
+/* B+ 트리를 나타내는 구조체. */
+typedef struct BPlusTree {
+    int length;
+    BPlusTreeNode *root;
+    BPlusTreeLeaf *first;
+    BPlusTreeLeaf *last;
+    Allocator allocator;
+} BPlusTree;
+
+/* B+ 트리의 키 하나를 가리키는 반복자를 나타내는 구조체. */
+typedef struct BPlusTreeIterator {
+    BPlusTreeLeaf *leaf;
+    int index;
+} BPlusTreeIterator;
+
+/* B+ 트리를 생성한다. */
+BPLUS_TREE_DEF BPlusTree *bplus_tree_create(void);
+
+/* 메모리 할당자 `allocator`를 사용하는 B+ 트리를 생성한다. */
+BPLUS_TREE_DEF BPlusTree *bplus_tree_create_with_allocator(const Allocator *allocator);
+
+/* B+ 트리 `tree`에 할당된 메모리를 해제한다. */
+BPLUS_TREE_DEF void bplus_tree_release(BPlusTree *tree);
+
+/* B+ 트리 `tree`에 들어 있는 모든 키를 제거한다. */
+BPLUS_TREE_DEF void bplus_tree_clear(BPlusTree *tree);
+
+/* B+ 트리 `tree`에 들어 있는 키의 개수를 반환한다. */
+BPLUS_TREE_DEF int bplus_tree_size(BPlusTree *tree);
+
+/* B+ 트리 `tree`가 비어 있는지 확인한다. */
+BPLUS_TREE_DEF bool bplus_tree_is_empty(BPlusTree *tree);
+
+/* 
+    B+ 트리 `tree`의 모든 키를 제거하고, 길이가 `count`인 정렬된 배열 `ptr`의 키로 B+ 트리를 한 번에 만든다.
+    
+    - 배열에 중복된 키가 있으면 하나만 추가한다.
+    - 배열이 정렬되어 있지 않으면 아무것도 하지 않고 `false`를 반환한다.
+*/
+BPLUS_TREE_DEF bool bplus_tree_bulk_load(BPlusTree *tree, const int *ptr, int count);
+
+/* 
+    B+ 트리 `tree`에 키 `key`를 추가하고, 새로운 키인지 여부를 반환한다.
+    
+    - 메모리를 할당하지 못하면 트리를 바꾸지 않고 `false`를 반환한다.
+*/
+BPLUS_TREE_DEF bool bplus_tree_insert(BPlusTree *tree, int key);
+
+/* B+ 트리 `tree`에서 키 `key`를 제거하고, 제거에 성공했는지 여부를 반환한다. */
+BPLUS_TREE_DEF bool bplus_tree_erase(BPlusTree *tree, int key);
+
+/* B+ 트리 `tree`에 키 `key`가 들어 있는지 확인한다. */
+BPLUS_TREE_DEF bool bplus_tree_contains(BPlusTree *tree, int key);
+
+/* B+ 트리 `tree`에서 `key` 이상인 첫 번째 키를 가리키는 반복자를 반환한다. */
+BPLUS_TREE_DEF BPlusTreeIterator bplus_tree_lower_bound(BPlusTree *tree, int key);
+
+/* B+ 트리 `tree`에서 가장 작은 키를 가리키는 반복자를 반환한다. */
+BPLUS_TREE_DEF BPlusTreeIterator bplus_tree_begin(BPlusTree *tree);
+
+/* B+ 트리 `tree`에서 `key`보다 작은 키의 개수를 반환한다. */
+BPLUS_TREE_DEF int bplus_tree_rank(BPlusTree *tree, int key);
+
+/* B+ 트리 `tree`에서 `index`번째로 작은 키 (0부터 시작)를 가리키는 반복자를 반환한다. */
+BPLUS_TREE_DEF BPlusTreeIterator bplus_tree_select(BPlusTree *tree, int index);
+
+/* 
+    B+ 트리 `tree`에서 `low` 이상 `high` 이하인 키를 최대 `count`개까지 배열 `result`에 
+    순서대로 복사하고, 복사한 키의 개수를 반환한다.
+*/
+BPLUS_TREE_DEF int bplus_tree_range(BPlusTree *tree, int low, int high, int *result, int count);
+
+/* 반복자 `it`이 B+ 트리의 키를 가리키고 있는지 확인한다. */
+BPLUS_TREE_DEF bool bplus_tree_iterator_is_valid(BPlusTreeIterator it);
+
+/* 반복자 `it`이 가리키는 키를 반환한다. */
+BPLUS_TREE_DEF int bplus_tree_iterator_get(BPlusTreeIterator it);
+
+/* 반복자 `it`이 다음 키를 가리키도록 한다. */
+BPLUS_TREE_DEF void bplus_tree_iterator_next(BPlusTreeIterator *it);
+
+/* 반복자 `it`이 이전 키를 가리키도록 한다. */
+BPLUS_TREE_DEF void bplus_tree_iterator_prev(BPlusTreeIterator *it);
+
+#endif // `BPLUS_TREE_H`
+
+#ifdef BPLUS_TREE_IMPLEMENTATION
+
+/* 리프 노드 `leaf`에서 `key` 이상인 첫 번째 키의 인덱스를 찾는다. */
+BPLUS_TREE_DEF int _bplus_tree_leaf_lower_bound(BPlusTreeLeaf *leaf, int key) {
+    int low = 0, high = leaf->node.count;
+    
+    while (low < high) {
+        int mid = (low + high) / 2;
+        
+        if (STATS_CMP(leaf->keys[mid] < key)) low = mid + 1;
+        else high = mid;
+    }
+    
+    return low;
+}
+
+/* 리프 노드 `leaf`에서 `key`보다 큰 첫 번째 키의 인덱스를 찾는다. */
+BPLUS_TREE_DEF int _bplus_tree_leaf_upper_bound(BPlusTreeLeaf *leaf, int key) {
+    int low = 0, high = leaf->node.count;
+    
+    while (low < high) {
+        int mid = (low + high) / 2;
+        
+        if (STATS_CMP(leaf->keys[mid] <= key)) low = mid + 1;
+        else high = mid;
+    }
+    
+    return low;
+}
+
+/* 내부 노드 `internal`에서 키 `key`가 들어 있어야 하는 자식 노드의 인덱스를 찾는다. */
+BPLUS_TREE_DEF int _bplus_tree_child_index(BPlusTreeInternal *internal, int key) {
+    int result = 0;
+    
+    // 노드가 캐시 라인 몇 개 크기이므로, 분기 없이 모든 키와 비교하는 편이 이진 탐색보다 빠르다.
+    for (int i = 1; i < internal->node.count; i++)
+        result += (internal->keys[i] <= key);
+    
+    STATS_ADD(comparisons, internal->node.count - 1);
+    
+    return result;
+}
+
+/* 노드 `node`를 루트로 하는 부분 트리에 들어 있는 키의 개수를 반환한다. */
+BPLUS_TREE_DEF int _bplus_tree_node_size(BPlusTreeNode *node) {
+    if (node->is_leaf) return node->count;
+    
+    BPlusTreeInternal *internal = (BPlusTreeInternal *) node;
+    
+    int result = 0;
+    
+    for (int i = 0; i < node->count; i++)
+        result += internal->sizes[i];
+    
+    return result;
+}
+
+/* B+ 트리 `tree`의 새로운 리프 노드를 생성한다. */
+BPLUS_TREE_DEF BPlusTreeLeaf *_bplus_tree_leaf_create(BPlusTree *tree) {
+    BPlusTreeLeaf *result = allocator_alloc(&tree->allocator, sizeof(BPlusTreeLeaf));
+    
+    if (result != NULL) result->node.is_leaf = true;
+    
+    return result;
+}
+
+/* B+ 트리 `tree`의 새로운 내부 노드를 생성한다. */
+BPLUS_TREE_DEF BPlusTreeInternal *_bplus_tree_internal_create(BPlusTree *tree) {
+    return allocator_alloc(&tree->allocator, sizeof(BPlusTreeInternal));
+}
+
+/* B+ 트리 `tree`의 노드 `node`에 할당된 메모리를 해제한다. */
+BPLUS_TREE_DEF void _bplus_tree_node_release(BPlusTree *tree, BPlusTreeNode *node) {
+    if (node->is_leaf) allocator_free(&tree->allocator, node, sizeof(BPlusTreeLeaf));
+    else allocator_free(&tree->allocator, node, sizeof(BPlusTreeInternal));
+}
+
+/* B+ 트리 `tree`의 노드 `node`를 루트로 하는 부분 트리에 할당된 메모리를 해제한다. */
+BPLUS_TREE_DEF void _bplus_tree_node_clear(BPlusTree *tree, BPlusTreeNode *node) {
+    if (!node->is_leaf) {
+        BPlusTreeInternal *internal = (BPlusTreeInternal *) node;
+        
+        for (int i = 0; i < node->count; i++)
+            _bplus_tree_node_clear(tree, internal->children[i]);
+    }
+    
+    _bplus_tree_node_release(tree, node);
+}
+
+/* 내부 노드 `internal`의 `index`번째 자리에 키 `key`, 자식 노드 `child`와 그 크기 `size`를 끼워 넣는다. */
+BPLUS_TREE_DEF void _bplus_tree_internal_insert_at(
+    BPlusTreeInternal *internal, 
+    int index, 
+    int key, 
+    BPlusTreeNode *child, 
+    int size
+) {
+    int count = internal->node.count - index;
+    
+    memmove(&internal->keys[index + 1], &internal->keys[index], count * sizeof(int));
+    memmove(&internal->sizes[index + 1], &internal->sizes[index], count * sizeof(int));
+    memmove(&internal->children[index + 1], &internal->children[index], count * sizeof(BPlusTreeNode *));
+    
+    internal->keys[index] = key;
+    internal->sizes[index] = size;
+    internal->children[index] = child;
+    
+    internal->node.count++;
+}
+
+/* 내부 노드 `internal`에서 `index`번째 키와 자식 노드를 제거한다. */
+BPLUS_TREE_DEF void _bplus_tree_internal_remove_at(BPlusTreeInternal *internal, int index) {
+    int count = internal->node.count - index - 1;
+    
+    memmove(&internal->keys[index], &internal->keys[index + 1], count * sizeof(int));
+    memmove(&internal->sizes[index], &internal->sizes[index + 1], count * sizeof(int));
+    memmove(&internal->children[index], &internal->children[index + 1], count * sizeof(BPlusTreeNode *));
+    
+    internal->node.count--;
+}
+
+/* 키를 추가하는 동안 노드를 분할할 때 사용하기 위해, 미리 할당해 둔 노드를 나타내는 구조체. */
+typedef struct _BPlusTreeSpares {
+    BPlusTreeLeaf *leaf;
+    BPlusTreeInternal *internals;
+} _BPlusTreeSpares;
+
+/* 
+    B+ 트리 `tree`에 키 `key`를 추가할 때 분할될 노드의 개수만큼, 새로운 노드를 `spares`에 미리 할당한다.
+    
+    - 내부 노드는 `children[0]`으로 서로 이어 저장한다.
+    - 노드를 모두 할당하지 못하면 할당한 노드를 해제하고 `false`를 반환한다. 
+      이렇게 하면 분할을 시작한 뒤에 할당에 실패하여 트리가 망가지는 일이 생기지 않는다.
+*/
+BPLUS_TREE_DEF bool _bplus_tree_reserve(BPlusTree *tree, int key, _BPlusTreeSpares *spares) {
+    BPlusTreeNode *node = tree->root;
+    
+    int depth = 0, full_count = 0;
+    
+    // 리프 노드 바로 위에서부터 연속으로 가득 차 있는 내부 노드의 개수를 센다.
+    while (!node->is_leaf) {
+        BPlusTreeInternal *internal = (BPlusTreeInternal *) node;
+        
+        full_count = (node->count == BPLUS_TREE_INTERNAL_CAPACITY) ? full_count + 1 : 0;
+        
+        depth++;
+        
+        node = internal->children[_bplus_tree_child_index(internal, key)];
+    }
+    
+    BPlusTreeLeaf *leaf = (BPlusTreeLeaf *) node;
+    
+    if (node->count < BPLUS_TREE_LEAF_CAPACITY) return true;
+    
+    int index = _bplus_tree_leaf_lower_bound(leaf, key);
+    
+    if (index < node->count && leaf->keys[index] == key) return true;
+    
+    // 루트 노드까지 분할되면, 새로운 루트 노드도 필요하다.
+    int internal_count = full_count + (full_count == depth);
+    
+    spares->leaf = _bplus_tree_leaf_create(tree);
+    
+    if (spares->leaf == NULL) return false;
+    
+    for (int i = 0; i < internal_count; i++) {
+        BPlusTreeInternal *internal = _bplus_tree_internal_create(tree);
+        
+        if (internal == NULL) {
+            _bplus_tree_node_release(tree, (BPlusTreeNode *) spares->leaf);
+            
+            while (spares->internals != NULL) {
+                BPlusTreeInternal *next = (BPlusTreeInternal *) spares->internals->children[0];
+                
+                _bplus_tree_node_release(tree, (BPlusTreeNode *) spares->internals);
+                
+                spares->internals = next;
+            }
+            
+            spares->leaf = NULL;
+            
+            return false;
+        }
+        
+        internal->children[0] = (BPlusTreeNode *) spares->internals;
+        spares->internals = internal;
+    }
+    
+    return true;
+}
+
+/* `spares`에 미리 할당해 둔 내부 노드 하나를 꺼낸다. */
+BPLUS_TREE_DEF BPlusTreeInternal *_bplus_tree_spare_internal(_BPlusTreeSpares *spares) {
+    BPlusTreeInternal *result = spares->internals;
+    
+    spares->internals = (BPlusTreeInternal *) result->children[0];
+    
+    return result;
+}
+
+/* 
+    B+ 트리 `tree`의 노드 `node`를 루트로 하는 부분 트리에 키 `key`를 추가한다.
+    
+    - 노드를 분할했으면 새로 만든 오른쪽 노드를 반환하고, 그 노드의 가장 작은 키를 `split_key`에 저장한다.
+    - 키를 새로 추가했는지 여부는 `inserted`에 저장한다.
+    - 노드를 분할할 때는 `_bplus_tree_reserve()`로 `spares`에 미리 할당해 둔 노드를 사용한다.
+*/
+BPLUS_TREE_DEF BPlusTreeNode *_bplus_tree_insert_helper(
+    BPlusTree *tree, 
+    BPlusTreeNode *node, 
+    int key, 
+    bool *inserted, 
+    int *split_key,
+    _BPlusTreeSpares *spares
+) {
+    if (node->is_leaf) {
+        BPlusTreeLeaf *leaf = (BPlusTreeLeaf *) node;
+        
+        int index = _bplus_tree_leaf_lower_bound(leaf, key);
+        
+        if (index < node->count && leaf->keys[index] == key) return NULL;
+        
+        BPlusTreeLeaf *result = NULL;
+        
+        // 리프 노드가 가득 차 있으면, 키의 절반을 새로운 리프 노드로 옮긴다.
+        if (node->count == BPLUS_TREE_LEAF_CAPACITY) {
+            result = spares->leaf;
+            
+            spares->leaf = NULL;
+            
+            int mid = node->count / 2;
+            
+            result->node.count = node->count - mid;
+            
+            memcpy(result->keys, &leaf->keys[mid], result->node.count * sizeof(int));
+            
+            STATS_ADD(moves, result->node.count);
+            
+            node->count = mid;
+            
+            result->prev = leaf;
+            result->next = leaf->next;
+            
+            if (leaf->next != NULL) leaf->next->prev = result;
+            else tree->last = result;
+            
+            leaf->next = result;
+            
+            if (index > mid) {
+                leaf = result;
+                index -= mid;
+            }
+        }
+        
+        memmove(&leaf->keys[index + 1], &leaf->keys[index], (leaf->node.count - index) * sizeof(int));
+        
+        STATS_ADD(moves, leaf->node.count - index);
+        
+        leaf->keys[index] = key;
+        leaf->node.count++;
+        
+        *inserted = true;
+        
+        if (result != NULL) *split_key = result->keys[0];
+        
+        return (BPlusTreeNode *) result;
+    }
+    
+    BPlusTreeInternal *internal = (BPlusTreeInternal *) node;
+    
+    int index = _bplus_tree_child_index(internal, key);
+    int child_key = 0;
+    
+    BPlusTreeNode *child = _bplus_tree_insert_helper(
+        tree, internal->children[index], key, inserted, &child_key, spares
+    );
+    
+    if (*inserted) internal->sizes[index]++;
+    
+    if (child == NULL) return NULL;
+    
+    int child_size = _bplus_tree_node_size(child);
+    
+    internal->sizes[index] -= child_size;
+    
+    BPlusTreeInternal *result = NULL;
+    
+    // 내부 노드가 가득 차 있으면, 자식 노드의 절반을 새로운 내부 노드로 옮긴다.
+    if (node->count == BPLUS_TREE_INTERNAL_CAPACITY) {
+        result = _bplus_tree_spare_internal(spares);
+        
+        int mid = node->count / 2;
+        
+        result->node.count = node->count - mid;
+        
+        memcpy(result->keys, &internal->keys[mid], result->node.count * sizeof(int));
+        memcpy(result->sizes, &internal->sizes[mid], result->node.count * sizeof(int));
+        memcpy(result->children, &internal->children[mid], result->node.count * sizeof(BPlusTreeNode *));
+        
+        node->count = mid;
+        
+        *split_key = result->keys[0];
+        
+        if (index >= mid) {
+            internal = result;
+            index -= mid;
+        }
+    }
+    
+    _bplus_tree_internal_insert_at(internal, index + 1, child_key, child, child_size);
+    
+    return (BPlusTreeNode *) result;
+}
+
+/* 
+    내부 노드 `internal`의 `index`번째 자식 노드에 키가 너무 적으면, 
+    형제 노드에서 키를 빌려 오거나 형제 노드와 합친다.
+*/
+BPLUS_TREE_DEF void _bplus_tree_rebalance(BPlusTree *tree, BPlusTreeInternal *internal, int index) {
+    BPlusTreeNode *child = internal->children[index];
+    
+    BPlusTreeNode *left = (index > 0) ? internal->children[index - 1] : NULL;
+    BPlusTreeNode *right = (index + 1 < internal->node.count) ? internal->children[index + 1] : NULL;
+    
+    if (child->is_leaf) {
+        if (child->count >= BPLUS_TREE_LEAF_CAPACITY / 2) return;
+        
+        BPlusTreeLeaf *leaf = (BPlusTreeLeaf *) child;
+        
+        if (left != NULL && left->count > BPLUS_TREE_LEAF_CAPACITY / 2) {
+            // 왼쪽 형제 노드의 가장 큰 키를 빌려 온다.
+            BPlusTreeLeaf *sibling = (BPlusTreeLeaf *) left;
+            
+            memmove(&leaf->keys[1], &leaf->keys[0], child->count * sizeof(int));
+            
+            leaf->keys[0] = sibling->keys[--left->count];
+            child->count++;
+            
+            internal->keys[index] = leaf->keys[0];
+            internal->sizes[index - 1]--;
+            internal->sizes[index]++;
+        } else if (right != NULL && right->count > BPLUS_TREE_LEAF_CAPACITY / 2) {
+            // 오른쪽 형제 노드의 가장 작은 키를 빌려 온다.
+            BPlusTreeLeaf *sibling = (BPlusTreeLeaf *) right;
+            
+            leaf->keys[child->count++] = sibling->keys[0];
+            
+            memmove(&sibling->keys[0], &sibling->keys[1], (--right->count) * sizeof(int));
+            
+            internal->keys[index + 1] = sibling->keys[0];
+            internal->sizes[index + 1]--;
+            internal->sizes[index]++;
+        } else {
+            // 빌려 올 키가 없으면, 오른쪽 노드를 왼쪽 노드에 합친다.
+            if (left != NULL) {
+                leaf = (BPlusTreeLeaf *) left;
+                index--;
+            }
+            
+            BPlusTreeLeaf *sibling = leaf->next;
+            
+            memcpy(&leaf->keys[leaf->node.count], sibling->keys, sibling->node.count * sizeof(int));
+            
+            STATS_ADD(moves, sibling->node.count);
+            
+            leaf->node.count += sibling->node.count;
+            leaf->next = sibling->next;
+            
+            if (sibling->next != NULL) sibling->next->prev = leaf;
+            else tree->last = leaf;
+            
+            internal->sizes[index] += internal->sizes[index + 1];
+            
+            _bplus_tree_internal_remove_at(internal, index + 1);
+            _bplus_tree_node_release(tree, (BPlusTreeNode *) sibling);
+        }
+    } else {
+        if (child->count >= BPLUS_TREE_INTERNAL_CAPACITY / 2) return;
+        
+        BPlusTreeInternal *node = (BPlusTreeInternal *) child;
+        
+        if (left != NULL && left->count > BPLUS_TREE_INTERNAL_CAPACITY / 2) {
+            // 왼쪽 형제 노드의 마지막 자식 노드를 빌려 온다.
+            BPlusTreeInternal *sibling = (BPlusTreeInternal *) left;
+            
+            int last = --left->count;
+            
+            node->keys[0] = internal->keys[index];
+            
+            _bplus_tree_internal_insert_at(node, 0, 0, sibling->children[last], sibling->sizes[last]);
+            
+            internal->keys[index] = sibling->keys[last];
+            internal->sizes[index - 1] -= sibling->sizes[last];
+            internal->sizes[index] += sibling->sizes[last];
+        } else if (right != NULL && right->count > BPLUS_TREE_INTERNAL_CAPACITY / 2) {
+            // 오른쪽 형제 노드의 첫 번째 자식 노드를 빌려 온다.
+            BPlusTreeInternal *sibling = (BPlusTreeInternal *) right;
+            
+            int size = sibling->sizes[0];
+            
+            _bplus_tree_internal_insert_at(node, child->count, internal->keys[index + 1], sibling->children[0], size);
+            
+            internal->keys[index + 1] = sibling->keys[1];
+            
+            _bplus_tree_internal_remove_at(sibling, 0);
+            
+            internal->sizes[index + 1] -= size;
+            internal->sizes[index] += size;
+        } else {
+            // 빌려 올 자식 노드가 없으면, 오른쪽 노드를 왼쪽 노드에 합친다.
+            if (left != NULL) {
+                node = (BPlusTreeInternal *) left;
+                index--;
+            }
+            
+            BPlusTreeInternal *sibling = (BPlusTreeInternal *) internal->children[index + 1];
+            
+            int count = node->node.count;
+            
+            memcpy(&node->keys[count], sibling->keys, sibling->node.count * sizeof(int));
+            memcpy(&node->sizes[count], sibling->sizes, sibling->node.count * sizeof(int));
+            memcpy(&node->children[count], sibling->children, sibling->node.count * sizeof(BPlusTreeNode *));
+            
+            node->keys[count] = internal->keys[index + 1];
+            node->node.count += sibling->node.count;
+            
+            internal->sizes[index] += internal->sizes[index + 1];
+            
+            _bplus_tree_internal_remove_at(internal, index + 1);
+            _bplus_tree_node_release(tree, (BPlusTreeNode *) sibling);
+        }
+    }
+}
+
+/* B+ 트리 `tree`의 노드 `node`를 루트로 하는 부분 트리에서 키 `key`를 제거한다. */
+BPLUS_TREE_DEF bool _bplus_tree_erase_helper(BPlusTree *tree, BPlusTreeNode *node, int key) {
+    if (node->is_leaf) {
+        BPlusTreeLeaf *leaf = (BPlusTreeLeaf *) node;
+        
+        int index = _bplus_tree_leaf_lower_bound(leaf, key);
+        
+        if (index >= node->count || leaf->keys[index] != key) return false;
+        
+        memmove(&leaf->keys[index], &leaf->keys[index + 1], (node->count - index - 1) * sizeof(int));
+        
+        STATS_ADD(moves, node->count - index - 1);
+        
+        node->count--;
+        
+        return true;
+    }
+    
+    BPlusTreeInternal *internal = (BPlusTreeInternal *) node;
+    
+    int index = _bplus_tree_child_index(internal, key);
+    
+    if (!_bplus_tree_erase_helper(tree, internal->children[index], key)) return false;
+    
+    internal->sizes[index]--;
+    
+    _bplus_tree_rebalance(tree, internal, index);
+    
+    return true;
+}
+
+/* B+ 트리를 생성한다. */
+BPLUS_TREE_DEF BPlusTree *bplus_tree_create(void) {
+    return bplus_tree_create_with_allocator(NULL);
+}
+
+/* 메모리 할당자 `allocator`를 사용하는 B+ 트리를 생성한다. */
+BPLUS_TREE_DEF BPlusTree *bplus_tree_create_with_allocator(const Allocator *allocator) {
+    BPlusTree *result = allocator_alloc(allocator, sizeof(BPlusTree));
+    
+    if (result != NULL && allocator != NULL) result->allocator = *allocator;
+    
+    return result;
+}
+
+/* B+ 트리 `tree`에 할당된 메모리를 해제한다. */
+BPLUS_TREE_DEF void bplus_tree_release(BPlusTree *tree) {
+    if (tree == NULL) return;
+    
+    bplus_tree_clear(tree);
+    
+    Allocator allocator = tree->allocator;
+    
+    allocator_free(&allocator, tree, sizeof(BPlusTree));
+}
+
+/* B+ 트리 `tree`에 들어 있는 모든 키를 제거한다. */
+BPLUS_TREE_DEF void bplus_tree_clear(BPlusTree *tree) {
+    if (tree == NULL) return;
+    
+    if (tree->root != NULL) _bplus_tree_node_clear(tree, tree->root);
+    
+    tree->length = 0;
+    tree->root = NULL;
+    tree->first = tree->last = NULL;
+}
+
+/* B+ 트리 `tree`에 들어 있는 키의 개수를 반환한다. */
+BPLUS_TREE_DEF int bplus_tree_size(BPlusTree *tree) {
+    return (tree != NULL) ? tree->length : -1;
+}
+
+/* B+ 트리 `tree`가 비어 있는지 확인한다. */
+BPLUS_TREE_DEF bool bplus_tree_is_empty(BPlusTree *tree) {
+    return (tree != NULL && tree->length <= 0);
+}
+
+/* B+ 트리 `tree`의 모든 키를 제거하고, 길이가 `count`인 정렬된 배열 `ptr`의 키로 B+ 트리를 한 번에 만든다. */
+BPLUS_TREE_DEF bool bplus_tree_bulk_load(BPlusTree *tree, const int *ptr, int count) {
+    /*
+        [일괄 적재의 동작 과정]
+        
+        1. 키를 순서대로 리프 노드에 채우고, 리프 노드를 연결 리스트로 잇는다.
+        2. 리프 노드를 순서대로 묶어 그 위 단계의 내부 노드를 만든다.
+        3. 이러한 작업을 노드가 하나만 남을 때까지 반복하고, 남은 노드를 루트로 삼는다.
+        
+        - 키를 각 노드에 고르게 나누어 채우므로, 모든 노드는 절반 이상 채워진다.
+        - 키를 하나씩 추가하는 것과 달리 노드를 분할하지 않으므로, 시간 복잡도는 `O(N)`이다.
+    */
+    
+    if (tree == NULL || (ptr == NULL && count > 0) || count < 0) return false;
+    
+    // 중복된 키를 제외한 키의 개수를 센다.
+    int length = (count > 0) ? 1 : 0;
+    
+    for (int i = 1; i < count; i++) {
+        if (ptr[i - 1] > ptr[i]) return false;
+        
+        length += (ptr[i - 1] != ptr[i]);
+    }
+    
+    if (length == 0) {
+        bplus_tree_clear(tree);
+        
+        return true;
+    }
+    
+    // 각 단계의 노드 개수를 미리 계산하여, 필요한 노드를 모두 할당한 다음에 트리를 만든다.
+    int leaf_count = (length + BPLUS_TREE_LEAF_CAPACITY - 1) / BPLUS_TREE_LEAF_CAPACITY;
+    int node_count = 0;
+    
+    for (int i = leaf_count;; i = (i + BPLUS_TREE_INTERNAL_CAPACITY - 1) / BPLUS_TREE_INTERNAL_CAPACITY) {
+        node_count += i;
+        
+        if (i == 1) break;
+    }
+    
+    BPlusTreeNode **nodes = allocator_alloc(NULL, node_count * sizeof(BPlusTreeNode *));
+    
+    if (nodes == NULL) return false;
+    
+    for (int i = 0; i < node_count; i++) {
+        nodes[i] = (i < leaf_count) 
+            ? (BPlusTreeNode *) _bplus_tree_leaf_create(tree) 
+            : (BPlusTreeNode *) _bplus_tree_internal_create(tree);
+        
+        if (nodes[i] == NULL) {
+            for (int j = 0; j < i; j++)
+                _bplus_tree_node_release(tree, nodes[j]);
+            
+            allocator_free(NULL, nodes, node_count * sizeof(BPlusTreeNode *));
+            
+            return false;
+        }
+    }
+    
+    bplus_tree_clear(tree);
+    
+    // 키를 리프 노드에 고르게 나누어 채운다.
+    for (int i = 0, j = 0; i < leaf_count; i++) {
+        BPlusTreeLeaf *leaf = (BPlusTreeLeaf *) nodes[i];
+        
+        leaf->node.count = length / leaf_count + (i < length % leaf_count);
+        
+        for (int k = 0; k < leaf->node.count; k++) {
+            leaf->keys[k] = ptr[j++];
+            
+            while (j < count && ptr[j] == ptr[j - 1]) j++;
+        }
+        
+        leaf->prev = (i > 0) ? (BPlusTreeLeaf *) nodes[i - 1] : NULL;
+        leaf->next = (i + 1 < leaf_count) ? (BPlusTreeLeaf *) nodes[i + 1] : NULL;
+    }
+    
+    // 노드가 하나만 남을 때까지, 노드를 묶어 그 위 단계의 내부 노드를 만든다.
+    int offset = 0;
+    
+    for (int i = leaf_count; i > 1;) {
+        int parent_count = (i + BPLUS_TREE_INTERNAL_CAPACITY - 1) / BPLUS_TREE_INTERNAL_CAPACITY;
+        
+        for (int j = 0, k = offset; j < parent_count; j++) {
+            BPlusTreeInternal *internal = (BPlusTreeInternal *) nodes[offset + i + j];
+            
+            internal->node.count = i / parent_count + (j < i % parent_count);
+            
+            for (int l = 0; l < internal->node.count; l++, k++) {
+                BPlusTreeNode *child = nodes[k];
+                
+                internal->children[l] = child;
+                internal->sizes[l] = _bplus_tree_node_size(child);
+                
+                // 자식 노드의 가장 작은 키를 구분 키로 사용한다.
+                while (!child->is_leaf) 
+                    child = ((BPlusTreeInternal *) child)->children[0];
+                
+                internal->keys[l] = ((BPlusTreeLeaf *) child)->keys[0];
+            }
+        }
+        
+        offset += i;
+        i = parent_count;
+    }
+    
+    tree->length = length;
+    tree->root = nodes[node_count - 1];
+    tree->first = (BPlusTreeLeaf *) nodes[0];
+    tree->last = (BPlusTreeLeaf *) nodes[leaf_count - 1];
+    
+    allocator_free(NULL, nodes, node_count * sizeof(BPlusTreeNode *));
+    
+    return true;
+}
+
+/* B+ 트리 `tree`에 키 `key`를 추가하고, 새로운 키인지 여부를 반환한다. */
+BPLUS_TREE_DEF bool bplus_tree_insert(BPlusTree *tree, int key) {
+    if (tree == NULL) return false;
+    
+    if (tree->root == NULL) {
+        BPlusTreeLeaf *leaf = _bplus_tree_leaf_create(tree);
+        
+        if (leaf == NULL) return false;
+        
+        tree->root = (BPlusTreeNode *) leaf;
+        tree->first = tree->last = leaf;
+    }
+    
+    _BPlusTreeSpares spares = { NULL, NULL };
+    
+    // 분할에 필요한 노드를 모두 할당하지 못하면, 트리를 바꾸지 않고 실패를 반환한다.
+    if (!_bplus_tree_reserve(tree, key, &spares)) return false;
+    
+    bool inserted = false;
+    
+    int split_key = 0;
+    
+    BPlusTreeNode *node = _bplus_tree_insert_helper(tree, tree->root, key, &inserted, &split_key, &spares);
+    
+    if (inserted) tree->length++;
+    
+    // 루트 노드가 분할되었으면, 두 노드를 자식으로 가지는 새로운 루트 노드를 만든다.
+    if (node != NULL) {
+        BPlusTreeInternal *root = _bplus_tree_spare_internal(&spares);
+        
+        int size = _bplus_tree_node_size(node);
+        
+        root->node.count = 2;
+        
+        root->children[0] = tree->root;
+        root->sizes[0] = tree->length - size;
+        
+        root->keys[1] = split_key;
+        root->children[1] = node;
+        root->sizes[1] = size;
+        
+        tree->root = (BPlusTreeNode *) root;
+    }
+    
+    return inserted;
+}
+
+/* B+ 트리 `tree`에서 키 `key`를 제거하고, 제거에 성공했는지 여부를 반환한다. */
+BPLUS_TREE_DEF bool bplus_tree_erase(BPlusTree *tree, int key) {
+    if (tree == NULL || tree->root == NULL) return false;
+    
+    if (!_bplus_tree_erase_helper(tree, tree->root, key)) return false;
+    
+    tree->length--;
+    
+    BPlusTreeNode *root = tree->root;
+    
+    // 루트 노드에 자식 노드가 하나만 남으면, 그 자식 노드를 새로운 루트 노드로 삼는다.
+    if (!root->is_leaf && root->count == 1) {
+        tree->root = ((BPlusTreeInternal *) root)->children[0];
+        
+        _bplus_tree_node_release(tree, root);
+    } else if (root->is_leaf && root->count == 0) {
+        bplus_tree_clear(tree);
+    }
+    
+    return true;
+}
+
+/* B+ 트리 `tree`에 키 `key`가 들어 있는지 확인한다. */
+BPLUS_TREE_DEF bool bplus_tree_contains(BPlusTree *tree, int key) {
+    BPlusTreeIterator it = bplus_tree_lower_bound(tree, key);
+    
+    return bplus_tree_iterator_is_valid(it) && bplus_tree_iterator_get(it) == key;
+}
+
+/* B+ 트리 `tree`에서 `key` 이상인 첫 번째 키를 가리키는 반복자를 반환한다. */
+BPLUS_TREE_DEF BPlusTreeIterator bplus_tree_lower_bound(BPlusTree *tree, int key) {
+    BPlusTreeIterator result = { NULL, 0 };
+    
+    if (tree == NULL || tree->root == NULL) return result;
+    
+    BPlusTreeNode *node = tree->root;
+    
+    while (!node->is_leaf) {
+        BPlusTreeInternal *internal = (BPlusTreeInternal *) node;
+        
+        node = internal->children[_bplus_tree_child_index(internal, key)];
+    }
+    
+    result.leaf = (BPlusTreeLeaf *) node;
+    result.index = _bplus_tree_leaf_lower_bound(result.leaf, key);
+    
+    // 리프 노드의 모든 키가 `key`보다 작으면, 다음 리프 노드의 첫 번째 키를 가리킨다.
+    if (result.index >= node->count) {
+        result.leaf = result.leaf->next;
+        result.index = 0;
+    }
+    
+    return result;
+}
+
+/* B+ 트리 `tree`에서 가장 작은 키를 가리키는 반복자를 반환한다. */
+BPLUS_TREE_DEF BPlusTreeIterator bplus_tree_begin(BPlusTree *tree) {
+    BPlusTreeIterator result = { (tree != NULL) ? tree->first : NULL, 0 };
+    
+    return result;
+}
+
+/* B+ 트리 `tree`에서 `key`보다 작은 키의 개수를 반환한다. */
+BPLUS_TREE_DEF int bplus_tree_rank(BPlusTree *tree, int key) {
+    if (tree == NULL) return -1;
+    
+    if (tree->root == NULL) return 0;
+    
+    BPlusTreeNode *node = tree->root;
+    
+    int result = 0;
+    
+    // 키가 들어 있어야 하는 자식 노드보다 왼쪽에 있는 부분 트리의 크기를 모두 더한다.
+    while (!node->is_leaf) {
+        BPlusTreeInternal *internal = (BPlusTreeInternal *) node;
+        
+        int index = _bplus_tree_child_index(internal, key);
+        
+        for (int i = 0; i < index; i++)
+            result += internal->sizes[i];
+        
+        node = internal->children[index];
+    }
+    
+    return result + _bplus_tree_leaf_lower_bound((BPlusTreeLeaf *) node, key);
+}
+
+/* B+ 트리 `tree`에서 `index`번째로 작은 키 (0부터 시작)를 가리키는 반복자를 반환한다. */
+BPLUS_TREE_DEF BPlusTreeIterator bplus_tree_select(BPlusTree *tree, int index) {
+    BPlusTreeIterator result = { NULL, 0 };
+    
+    if (tree == NULL || index < 0 || index >= tree->length) return result;
+    
+    BPlusTreeNode *node = tree->root;
+    
+    // 부분 트리의 크기를 빼 나가면서 `index`번째 키가 들어 있는 자식 노드를 찾는다.
+    while (!node->is_leaf) {
+        BPlusTreeInternal *internal = (BPlusTreeInternal *) node;
+        
+        int i = 0;
+        
+        while (index >= internal->sizes[i]) 
+            index -= internal->sizes[i++];
+        
+        node = internal->children[i];
+    }
+    
+    result.leaf = (BPlusTreeLeaf *) node;
+    result.index = index;
+    
+    return result;
+}
+
+/* B+ 트리 `tree`에서 `low` 이상 `high` 이하인 키를 최대 `count`개까지 배열 `result`에 복사한다. */
+BPLUS_TREE_DEF int bplus_tree_range(BPlusTree *tree, int low, int high, int *result, int count) {
+    if (tree == NULL || result == NULL || count <= 0 || low > high) return 0;
+    
+    BPlusTreeIterator it = bplus_tree_lower_bound(tree, low);
+    
+    int length = 0;
+    
+    // 리프 노드의 연결 리스트를 따라가며, 노드 하나씩 키를 통째로 복사한다.
+    while (it.leaf != NULL && length < count) {
+        BPlusTreeLeaf *leaf = it.leaf;
+        
+        int end = _bplus_tree_leaf_upper_bound(leaf, high);
+        
+        if (end - it.index > count - length) end = it.index + (count - length);
+        
+        if (end <= it.index) break;
+        
+        memcpy(&result[length], &leaf->keys[it.index], (end - it.index) * sizeof(int));
+        
+        length += end - it.index;
+        
+        if (end < leaf->node.count) break;
+        
+        it.leaf = leaf->next;
+        it.index = 0;
+    }
+    
+    return length;
+}
+
+/* 반복자 `it`이 B+ 트리의 키를 가리키고 있는지 확인한다. */
+BPLUS_TREE_DEF bool bplus_tree_iterator_is_valid(BPlusTreeIterator it) {
+    return it.leaf != NULL && it.index >= 0 && it.index < it.leaf->node.count;
+}
+
+/* 반복자 `it`이 가리키는 키를 반환한다. */
+BPLUS_TREE_DEF int bplus_tree_iterator_get(BPlusTreeIterator it) {
+    return bplus_tree_iterator_is_valid(it) ? it.leaf->keys[it.index] : -1;
+}
+
+/* 반복자 `it`이 다음 키를 가리키도록 한다. */
+BPLUS_TREE_DEF void bplus_tree_iterator_next(BPlusTreeIterator *it) {
+    if (it == NULL || it->leaf == NULL) return;
+    
+    if (++it->index >= it->leaf->node.count) {
+        it->leaf = it->leaf->next;
+        it->index = 0;
+    }
+}
+
+/* 반복자 `it`이 이전 키를 가리키도록 한다. */
+BPLUS_TREE_DEF void bplus_tree_iterator_prev(BPlusTreeIterator *it) {
+    if (it == NULL || it->leaf == NULL) return;
+    
+    if (--it->index < 0) {
+        it->leaf = it->leaf->prev;
+        it->index = (it->leaf != NULL) ? it->leaf->node.count - 1 : 0;
+    }
+}
+
+#endif // `BPLUS_TREE_IMPLEMENTATION`
\ No newline at end of file
@@ -0,0 +1,384 @@
+/*
+    Copyright (c) 2021 jdeokkim
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+#include "stats.h"
+#include "trace.h"
+
+#define HASH_MAP_DEF static
+
+/* 해시 테이블의 최소 버킷 개수. */
+#define HASH_MAP_MIN_CAPACITY 8
+
+/* 해시 테이블의 최대 버킷 개수. */
+#define HASH_MAP_MAX_CAPACITY (1 << 30)
+
+/* 해시 테이블의 기본 최대 적재율. */
+#define HASH_MAP_DEFAULT_MAX_LOAD_FACTOR 0.8f
+
+/* 해시 테이블의 버킷을 나타내는 구조체. */
+typedef struct HashMapEntry {
+    unsigned int distance;
+    int key;
+    int value;
+} HashMapEntry;
+
+/* 해시 테이블을 나타내는 구조체. */
+typedef struct HashMap {
+    int length;
+    int capacity;
+    float max_load_factor;
+    HashMapEntry *ptr;
+    Allocator allocator;
+} HashMap;
+
+/* 해시 테이블을 생성한다. */
+HASH_MAP_DEF HashMap *hash_map_create(void);
+
+/* 메모리 할당자 `allocator`를 사용하는 해시 테이블을 생성한다. */
+HASH_MAP_DEF HashMap *hash_map_create_with_allocator(const Allocator *allocator);
+
+/* 해시 테이블 `map`에 할당된 메모리를 해제한다. */
+HASH_MAP_DEF void hash_map_release(HashMap *map);
+
+/* 해시 테이블 `map`에 들어 있는 모든 키를 제거한다. */
+HASH_MAP_DEF void hash_map_clear(HashMap *map);
+
+/* 해시 테이블 `map`에 들어 있는 키의 개수를 반환한다. */
+HASH_MAP_DEF int hash_map_size(HashMap *map);
+
+/* 해시 테이블 `map`이 비어 있는지 확인한다. */
+HASH_MAP_DEF bool hash_map_is_empty(HashMap *map);
+
+/* 해시 테이블 `map`의 현재 적재율을 반환한다. */
+HASH_MAP_DEF float hash_map_load_factor(HashMap *map);
+
+/* 해시 테이블 `map`의 최대 적재율을 `factor`로 설정한다. */
+HASH_MAP_DEF void hash_map_set_max_load_factor(HashMap *map, float factor);
+
+/* 
+    해시 테이블 `map`이 키를 `count`개까지 재해싱 없이 담을 수 있도록 하고, 성공 여부를 반환한다.
+
+    - 메모리를 할당하지 못하면 해시 테이블을 바꾸지 않고 `false`를 반환한다.
+*/
+HASH_MAP_DEF bool hash_map_reserve(HashMap *map, int count);
+
+/* 
+    해시 테이블 `map`의 버킷 개수를 `capacity` 이상으로 바꾸고, 모든 키를 다시 배치한 다음 성공 여부를 반환한다.
+
+    - 메모리를 할당하지 못하면 해시 테이블을 바꾸지 않고 `false`를 반환한다.
+*/
+HASH_MAP_DEF bool hash_map_rehash(HashMap *map, int capacity);
+
+/* 
+    해시 테이블 `map`에 키 `key`와 값 `value`를 추가하고, 새로운 키인지 여부를 반환한다.
+
+    - 재해싱에 필요한 메모리를 할당하지 못하면 키를 추가하지 않고 `false`를 반환한다.
+*/
+HASH_MAP_DEF bool hash_map_insert(HashMap *map, int key, int value);
+
+/* 해시 테이블 `map`에 키 `key`가 들어 있는지 확인한다. */
+HASH_MAP_DEF bool hash_map_contains(HashMap *map, int key);
+
+/* 해시 테이블 `map`에서 키 `key`에 대응하는 값을 반환한다. */
+HASH_MAP_DEF int hash_map_get(HashMap *map, int key);
+
+/* 해시 테이블 `map`에서 키 `key`를 제거하고, 제거에 성공했는지 여부를 반환한다. */
+HASH_MAP_DEF bool hash_map_remove(HashMap *map, int key);
+
+#endif // `HASH_MAP_H`
+
+#ifdef HASH_MAP_IMPLEMENTATION
+
+/* 키 `key`의 해시 값을 반환한다. */
+HASH_MAP_DEF uint32_t _hash_map_hash(int key) {
+    // MurmurHash3의 `fmix32` 함수를 사용하여 연속된 키도 고르게 분산시킨다.
+    uint32_t result = (uint32_t) key;
+
+    result ^= result >> 16;
+    result *= 0x85ebca6bU;
+    result ^= result >> 13;
+    result *= 0xc2b2ae35U;
+    result ^= result >> 16;
+
+    return result;
+}
+
+/* 해시 테이블 `map`에서 키 `key`가 들어 있는 버킷의 인덱스를 찾는다. */
+HASH_MAP_DEF int _hash_map_find(HashMap *map, int key) {
+    if (map == NULL || map->length <= 0) return -1;
+
+    uint32_t mask = map->capacity - 1;
+    uint32_t i = _hash_map_hash(key) & mask;
+
+    for (unsigned int distance = 1;; distance++) {
+        HashMapEntry *entry = &map->ptr[i];
+
+        /*
+            로빈 후드 해싱에서는 각 버킷의 탐사 거리가 단조롭게 유지되므로,
+            현재 탐사 거리보다 짧은 거리의 버킷을 만나면 키가 존재하지 않는 것이다.
+        */
+        if (entry->distance < distance) return -1;
+        if (STATS_CMP(entry->key == key)) return i;
+
+        i = (i + 1) & mask;
+    }
+}
+
+/* 해시 테이블 `map`에 키 `key`와 값 `value`를 배치한다. */
+HASH_MAP_DEF void _hash_map_place(HashMap *map, int key, int value) {
+    uint32_t mask = map->capacity - 1;
+    uint32_t i = _hash_map_hash(key) & mask;
+
+    HashMapEntry carry = { 1, key, value };
+
+    for (;;) {
+        HashMapEntry *entry = &map->ptr[i];
+
+        if (entry->distance == 0) {
+            *entry = carry;
+
+            return;
+        }
+
+        // 자기 자리에 더 가까운 ("부유한") 항목을 밀어내고, 밀려난 항목의 배치를 이어서 한다.
+        if (entry->distance < carry.distance) {
+            HashMapEntry temp_entry = *entry;
+
+            *entry = carry;
+            carry = temp_entry;
+        }
+
+        i = (i + 1) & mask;
+
+        carry.distance++;
+    }
+}
+
+/* 키를 `count`개 담기 위해 필요한 버킷의 개수를 반환한다. */
+HASH_MAP_DEF int _hash_map_capacity_for(HashMap *map, int count) {
+    int result = HASH_MAP_MIN_CAPACITY;
+
+    while (result < HASH_MAP_MAX_CAPACITY && count > (int) (result * map->max_load_factor))
+        result *= 2;
+
+    return result;
+}
+
+/* 해시 테이블을 생성한다. */
+HASH_MAP_DEF HashMap *hash_map_create(void) {
+    return hash_map_create_with_allocator(NULL);
+}
+
+/* 메모리 할당자 `allocator`를 사용하는 해시 테이블을 생성한다. */
+HASH_MAP_DEF HashMap *hash_map_create_with_allocator(const Allocator *allocator) {
+    HashMap *result = allocator_alloc(allocator, sizeof(HashMap));
+
+    if (result == NULL) return NULL;
+
+    if (allocator != NULL) result->allocator = *allocator;
+
+    result->capacity = HASH_MAP_MIN_CAPACITY;
+    result->max_load_factor = HASH_MAP_DEFAULT_MAX_LOAD_FACTOR;
+    result->ptr = allocator_alloc(allocator, result->capacity * sizeof(HashMapEntry));
+
+    if (result->ptr == NULL) {
+        allocator_free(allocator, result, sizeof(HashMap));
+
+        return NULL;
+    }
+
+    return result;
+}
+
+/* 해시 테이블 `map`에 할당된 메모리를 해제한다. */
+HASH_MAP_DEF void hash_map_release(HashMap *map) {
+    if (map == NULL) return;
+
+    Allocator allocator = map->allocator;
+
+    allocator_free(&allocator, map->ptr, map->capacity * sizeof(HashMapEntry));
+    allocator_free(&allocator, map, sizeof(HashMap));
+}
+
+/* 해시 테이블 `map`에 들어 있는 모든 키를 제거한다. */
+HASH_MAP_DEF void hash_map_clear(HashMap *map) {
+    if (map == NULL) return;
+
+    for (int i = 0; i < map->capacity; i++)
+        map->ptr[i].distance = 0;
+
+    map->length = 0;
+}
+
+/* 해시 테이블 `map`에 들어 있는 키의 개수를 반환한다. */
+HASH_MAP_DEF int hash_map_size(HashMap *map) {
+    return (map != NULL) ? map->length : 0;
+}
+
+/* 해시 테이블 `map`이 비어 있는지 확인한다. */
+HASH_MAP_DEF bool hash_map_is_empty(HashMap *map) {
+    return (map == NULL) || (map != NULL && map->length == 0);
+}
+
+/* 해시 테이블 `map`의 현재 적재율을 반환한다. */
+HASH_MAP_DEF float hash_map_load_factor(HashMap *map) {
+    return (map != NULL) ? (float) map->length / map->capacity : 0.0f;
+}
+
+/* 해시 테이블 `map`의 최대 적재율을 `factor`로 설정한다. */
+HASH_MAP_DEF void hash_map_set_max_load_factor(HashMap *map, float factor) {
+    if (map == NULL || factor < 0.1f || factor > 0.95f) return;
+
+    map->max_load_factor = factor;
+
+    if (map->length > (int) (map->capacity * factor))
+        hash_map_rehash(map, 0);
+}
+
+/* 해시 테이블 `map`이 키를 `count`개까지 재해싱 없이 담을 수 있도록 한다. */
+HASH_MAP_DEF bool hash_map_reserve(HashMap *map, int count) {
+    if (map == NULL) return false;
+
+    if (count <= (int) (map->capacity * map->max_load_factor)) return true;
+
+    return hash_map_rehash(map, _hash_map_capacity_for(map, count));
+}
+
+/* 해시 테이블 `map`의 버킷 개수를 `capacity` 이상으로 바꾸고, 모든 키를 다시 배치한다. */
+HASH_MAP_DEF bool hash_map_rehash(HashMap *map, int capacity) {
+    if (map == NULL) return false;
+
+    int new_capacity = _hash_map_capacity_for(map, map->length);
+
+    while (new_capacity < capacity && new_capacity < HASH_MAP_MAX_CAPACITY)
+        new_capacity *= 2;
+
+    // 새로운 버킷 배열을 먼저 할당하고, 할당에 실패하면 기존의 버킷 배열을 그대로 둔다.
+    HashMapEntry *new_ptr = allocator_alloc(&map->allocator, new_capacity * sizeof(HashMapEntry));
+
+    if (new_ptr == NULL) return false;
+
+    TRACE_BEGIN(rehash);
+
+    HashMapEntry *old_ptr = map->ptr;
+    int old_capacity = map->capacity;
+
+    map->capacity = new_capacity;
+    map->ptr = new_ptr;
+
+    for (int i = 0; i < old_capacity; i++) {
+        if (old_ptr[i].distance == 0) continue;
+
+        _hash_map_place(map, old_ptr[i].key, old_ptr[i].value);
+    }
+
+    allocator_free(&map->allocator, old_ptr, old_capacity * sizeof(HashMapEntry));
+
+    TRACE_END(rehash, "hash_map_rehash");
+
+    return true;
+}
+
+/* 해시 테이블 `map`에 키 `key`와 값 `value`를 추가하고, 새로운 키인지 여부를 반환한다. */
+HASH_MAP_DEF bool hash_map_insert(HashMap *map, int key, int value) {
+    /*
+        [로빈 후드 해싱의 동작 과정]
+
+        1. 키의 해시 값으로 시작 버킷을 정하고, 빈 버킷을 찾을 때까지 다음 버킷으로 이동한다.
+        2. 이동하는 도중에 시작 버킷으로부터의 거리가 현재 항목보다 짧은 항목을 만나면,
+           그 항목과 자리를 바꾸고 밀려난 항목으로 1번 과정을 계속한다.
+
+        [로빈 후드 해싱의 성능]
+
+        - 모든 항목의 탐사 거리가 고르게 유지되므로, 적재율이 높아도 평균 탐사 횟수는
+          1 ~ 2번 정도로 유지된다.
+        - 키를 제거할 때는 뒤따르는 항목들을 한 칸씩 앞으로 당기므로 (backward shift),
+          별도의 삭제 표시 (tombstone)가 필요하지 않다.
+    */
+
+    if (map == NULL) return false;
+
+    int index = _hash_map_find(map, key);
+
+    if (index >= 0) {
+        map->ptr[index].value = value;
+
+        return false;
+    }
+
+    if (map->length + 1 > (int) (map->capacity * map->max_load_factor)) {
+        if (!hash_map_rehash(map, 2 * map->capacity)) return false;
+    }
+
+    _hash_map_place(map, key, value);
+
+    map->length++;
+
+    return true;
+}
+
+/* 해시 테이블 `map`에 키 `key`가 들어 있는지 확인한다. */
+HASH_MAP_DEF bool hash_map_contains(HashMap *map, int key) {
+    return _hash_map_find(map, key) >= 0;
+}
+
+/* 해시 테이블 `map`에서 키 `key`에 대응하는 값을 반환한다. */
+HASH_MAP_DEF int hash_map_get(HashMap *map, int key) {
+    int index = _hash_map_find(map, key);
+
+    return (index >= 0) ? map->ptr[index].value : -1;
+}
+
+/* 해시 테이블 `map`에서 키 `key`를 제거하고, 제거에 성공했는지 여부를 반환한다. */
+HASH_MAP_DEF bool hash_map_remove(HashMap *map, int key) {
+    int index = _hash_map_find(map, key);
+
+    if (index < 0) return false;
+
+    uint32_t mask = map->capacity - 1;
+    uint32_t i = index, j = (i + 1) & mask;
+
+    // 자기 자리에 있지 않은 항목들을 한 칸씩 앞으로 당긴다.
+    while (map->ptr[j].distance > 1) {
+        map->ptr[i] = map->ptr[j];
+        map->ptr[i].distance--;
+
+        i = j;
+        j = (j + 1) & mask;
+    }
+
+    map->ptr[i].distance = 0;
+    map->length--;
+
+    return true;
+}
+
+#endif // `HASH_MAP_IMPLEMENTATION`
\ No newline at end of file
@@ -26,6 +26,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "allocator.h"
+
 #define LINKED_LIST_DEF static
 
 /* 단일 연결 리스트의 항목을 나타내는 구조체. */
@@ -38,11 +40,15 @@ typedef struct SinglyLinkedNode {
 typedef struct SinglyLinkedList {
     SinglyLinkedNode *front;
     SinglyLinkedNode *back;
+    Allocator allocator;
 } SinglyLinkedList;
 
 /* 단일 연결 리스트를 생성한다. */
 LINKED_LIST_DEF SinglyLinkedList *sll_create(void);
 
+/* 메모리 할당자 `allocator`를 사용하는 단일 연결 리스트를 생성한다. */
+LINKED_LIST_DEF SinglyLinkedList *sll_create_with_allocator(const Allocator *allocator);
+
 /* 단일 연결 리스트 `ll`에 할당된 메모리를 해제한다. */
 LINKED_LIST_DEF void sll_release(SinglyLinkedList *ll);
 
@@ -73,27 +79,42 @@ LINKED_LIST_DEF int sll_pop_back(SinglyLinkedList *ll);
 
 /* 단일 연결 리스트를 생성한다. */
 LINKED_LIST_DEF SinglyLinkedList *sll_create(void) {
-    return calloc(1, sizeof(SinglyLinkedList));
+    return sll_create_with_allocator(NULL);
+}
+
+/* 메모리 할당자 `allocator`를 사용하는 단일 연결 리스트를 생성한다. */
+LINKED_LIST_DEF SinglyLinkedList *sll_create_with_allocator(const Allocator *allocator) {
+    SinglyLinkedList *result = allocator_alloc(allocator, sizeof(SinglyLinkedList));
+    
+    if (result == NULL) return NULL;
+    
+    if (allocator != NULL) result->allocator = *allocator;
+    
+    return result;
 }
 
 /* 단일 연결 리스트 `ll`에 할당된 메모리를 해제한다. */
 LINKED_LIST_DEF void sll_release(SinglyLinkedList *ll) {
+    if (ll == NULL) return;
+    
     sll_clear(ll);
     
-    free(ll);
+    Allocator allocator = ll->allocator;
+    
+    allocator_free(&allocator, ll, sizeof(SinglyLinkedList));
 }
 
-/* 단일 연결 리스트의 항목 `node`에 할당된 메모리를 해제한다. */
-LINKED_LIST_DEF void _sll_node_release(SinglyLinkedNode *node) {
-    free(node);
+/* 단일 연결 리스트 `ll`의 항목 `node`에 할당된 메모리를 해제한다. */
+LINKED_LIST_DEF void _sll_node_release(SinglyLinkedList *ll, SinglyLinkedNode *node) {
+    allocator_free(&ll->allocator, node, sizeof(SinglyLinkedNode));
 }
 
-/* 단일 연결 리스트의 항목 `node`와 연결된 모든 항목을 제거한다. */
-LINKED_LIST_DEF void _sll_node_clear(SinglyLinkedNode *node) {
+/* 단일 연결 리스트 `ll`의 항목 `node`와 연결된 모든 항목을 제거한다. */
+LINKED_LIST_DEF void _sll_node_clear(SinglyLinkedList *ll, SinglyLinkedNode *node) {
     if (node == NULL || node->next == NULL) return;
     
-    _sll_node_clear(node->next);
-    _sll_node_release(node->next);
+    _sll_node_clear(ll, node->next);
+    _sll_node_release(ll, node->next);
     
     node->next = NULL;
 }
@@ -102,8 +123,8 @@ LINKED_LIST_DEF void _sll_node_clear(SinglyLinkedNode *node) {
 LINKED_LIST_DEF void sll_clear(SinglyLinkedList *ll) {
     if (ll == NULL) return;
     
-    _sll_node_clear(ll->front);
-    _sll_node_release(ll->front);
+    _sll_node_clear(ll, ll->front);
+    _sll_node_release(ll, ll->front);
     
     ll->front = ll->back = NULL;
 }
@@ -118,22 +139,25 @@ LINKED_LIST_DEF SinglyLinkedNode *sll_back(SinglyLinkedList *ll) {
     return ll->back;
 }
 
-/* 단일 연결 리스트를 생성한다. */
-LINKED_LIST_DEF SinglyLinkedNode *_sll_node_create(int value) {
-    SinglyLinkedNode *result = calloc(1, sizeof(SinglyLinkedNode));
+/* 단일 연결 리스트 `ll`의 새로운 항목을 생성한다. */
+LINKED_LIST_DEF SinglyLinkedNode *_sll_node_create(SinglyLinkedList *ll, int value) {
+    SinglyLinkedNode *result = allocator_alloc(&ll->allocator, sizeof(SinglyLinkedNode));
     
-    result->value = value;
+    if (result != NULL) result->value = value;
     
     return result;
 }
 
 /* 단일 연결 리스트 `ll`의 시작 부분에 새로운 항목을 추가한다. */
 LINKED_LIST_DEF void sll_push_front(SinglyLinkedList *ll, int value) {
+    SinglyLinkedNode *front = _sll_node_create(ll, value);
+    
+    // 메모리를 할당하지 못하면, 항목을 추가하지 않는다.
+    if (front == NULL) return;
+    
     if (ll->front == NULL && ll->back == NULL) {
-        ll->front = ll->back = _sll_node_create(value);
+        ll->front = ll->back = front;
     } else {
-        SinglyLinkedNode *front = _sll_node_create(value);
-        
         front->next = ll->front;
         
         ll->front = front;
@@ -145,7 +169,9 @@ LINKED_LIST_DEF void sll_push_back(SinglyLinkedList *ll, int value) {
     if (ll->front == NULL && ll->back == NULL) {
         sll_push_front(ll, value);
     } else {
-        SinglyLinkedNode *back = _sll_node_create(value);
+        SinglyLinkedNode *back = _sll_node_create(ll, value);
+        
+        if (back == NULL) return;
         
         ll->back->next = back;
         ll->back = back;
@@ -158,12 +184,14 @@ LINKED_LIST_DEF int sll_pop_front(SinglyLinkedList *ll) {
     
     SinglyLinkedNode *front = ll->front;
     
+    SinglyLinkedNode *next = front->next;
+    
     int result = front->value;
     
-    _sll_node_release(ll->front);
+    _sll_node_release(ll, front);
     
-    if (front->next == NULL) ll->front = ll->back = NULL;
-    else ll->front = front->next;
+    if (next == NULL) ll->front = ll->back = NULL;
+    else ll->front = next;
     
     return result;
 }
@@ -177,7 +205,7 @@ LINKED_LIST_DEF int sll_pop_back(SinglyLinkedList *ll) {
     if (front->next == NULL) {
         int result = front->value;
         
-        _sll_node_release(front);
+        _sll_node_release(ll, front);
         
         ll->front = ll->back = NULL;
         
@@ -188,10 +216,12 @@ LINKED_LIST_DEF int sll_pop_back(SinglyLinkedList *ll) {
         
         int result = front->next->value;
         
-        _sll_node_release(front->next);
+        _sll_node_release(ll, front->next);
         
         front->next = NULL;
         
+        ll->back = front;
+        
         return result;
     }
 }
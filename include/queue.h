@@ -28,6 +28,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "allocator.h"
+
 #define QUEUE_DEF static
 
 /* 큐의 연결 리스트의 항목을 나타내는 구조체. */
@@ -46,11 +48,15 @@ typedef struct QueueList {
 typedef struct Queue {
     int length;
     QueueList *ll;
+    Allocator allocator;
 } Queue;
 
 /* 큐를 생성한다. */
 QUEUE_DEF Queue *queue_create(void);
 
+/* 메모리 할당자 `allocator`를 사용하는 큐를 생성한다. */
+QUEUE_DEF Queue *queue_create_with_allocator(const Allocator *allocator);
+
 /* 큐 `queue`에 할당된 메모리를 해제한다. */
 QUEUE_DEF void queue_release(Queue *queue);
 
@@ -77,23 +83,44 @@ QUEUE_DEF int queue_back(Queue *queue);
 
 #endif // `QUEUE_H`
 
-#ifdef QUEUE_IMPLEMENTATION
+/* 다른 헤더 파일을 통해 여러 번 포함되더라도 구현 부분은 한 번만 정의한다. */
+#if defined(QUEUE_IMPLEMENTATION) && !defined(QUEUE_IMPLEMENTATION_ONCE)
+#define QUEUE_IMPLEMENTATION_ONCE
 
 /* 큐를 생성한다. */
 QUEUE_DEF Queue *queue_create(void) {
-    Queue *result = calloc(1, sizeof(Queue));
+    return queue_create_with_allocator(NULL);
+}
+
+/* 메모리 할당자 `allocator`를 사용하는 큐를 생성한다. */
+QUEUE_DEF Queue *queue_create_with_allocator(const Allocator *allocator) {
+    Queue *result = allocator_alloc(allocator, sizeof(Queue));
+    
+    if (result == NULL) return NULL;
+    
+    if (allocator != NULL) result->allocator = *allocator;
+    
+    result->ll = allocator_alloc(allocator, sizeof(QueueList));
     
-    result->ll = calloc(1, sizeof(QueueList));
+    if (result->ll == NULL) {
+        allocator_free(allocator, result, sizeof(Queue));
+        
+        return NULL;
+    }
     
     return result;
 }
 
 /* 큐 `queue`에 할당된 메모리를 해제한다. */
 QUEUE_DEF void queue_release(Queue *queue) {
+    if (queue == NULL) return;
+    
     queue_clear(queue);
     
-    free(queue->ll);
-    free(queue);
+    Allocator allocator = queue->allocator;
+    
+    allocator_free(&allocator, queue->ll, sizeof(QueueList));
+    allocator_free(&allocator, queue, sizeof(Queue));
 }
 
 /* 큐 `queue`에 들어 있는 모든 값을 제거한다. */
@@ -107,11 +134,13 @@ QUEUE_DEF void queue_clear(Queue *queue) {
     while (front != NULL) {
         QueueNode *node = front->next;
         
-        free(front);
+        allocator_free(&queue->allocator, front, sizeof(QueueNode));
         front = node;
     }
     
     ll->front = ll->back = NULL;
+    
+    queue->length = 0;
 }
 
 /* 큐 `queue`에 들어 있는 값의 개수를 반환한다. */
@@ -130,7 +159,11 @@ QUEUE_DEF void queue_push(Queue *queue, unsigned int value) {
     
     QueueList *ll = queue->ll;
     
-    QueueNode *node = calloc(1, sizeof(QueueNode));
+    QueueNode *node = allocator_alloc(&queue->allocator, sizeof(QueueNode));
+    
+    // 메모리를 할당하지 못하면, 값을 추가하지 않는다.
+    if (node == NULL) return;
+    
     node->value = value;
     
     if (ll->front == NULL && ll->back == NULL) {
@@ -156,7 +189,7 @@ QUEUE_DEF int queue_pop(Queue *queue) {
             
         QueueNode *node = ll->front->next;
         
-        free(ll->front);
+        allocator_free(&queue->allocator, ll->front, sizeof(QueueNode));
         
         if (node == NULL) ll->front = ll->back = NULL;
         else ll->front = node;
@@ -0,0 +1,429 @@
+/*
+    Copyright (c) 2021 jdeokkim
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "binary_heap.h"
+#include "stack.h"
+
+#if ALLOCATOR_HAS_VM
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#endif
+
+/* 
+    `queue._h`를 이 헤더 파일보다 먼저 포함했을 때만 배열 기반 큐의 스냅숏을 지원한다.
+    
+    - `queue.h`와 `queue._h`는 같은 이름을 사용하므로, 이 헤더 파일에서 직접 포함하지 않는다.
+*/
+#if defined(QUEUE_H) && defined(QUEUE_INLINE_CAPACITY)
+    #define SNAPSHOT_HAS_QUEUE 1
+#else
+    #define SNAPSHOT_HAS_QUEUE 0
+#endif
+
+#define SNAPSHOT_DEF static
+
+/* 스냅숏 파일의 식별 번호 (`"ALSN"`). */
+#define SNAPSHOT_MAGIC 0x4e534c41U
+
+/* 스냅숏 파일 형식의 버전. */
+#define SNAPSHOT_VERSION 1
+
+/* 스냅숏에 저장된 자료 구조의 종류. */
+typedef enum SnapshotKind {
+    SNAPSHOT_KIND_STACK = 1,
+    SNAPSHOT_KIND_BINARY_HEAP,
+    SNAPSHOT_KIND_QUEUE,
+    SNAPSHOT_KIND_SORTED_ARRAY
+} SnapshotKind;
+
+/* 
+    스냅숏 파일의 헤더를 나타내는 구조체.
+    
+    - 헤더 바로 뒤에 자료 구조의 `ptr` 버퍼가 그대로 저장되며, 헤더의 크기는 64바이트이다.
+    - 이진 힙은 `ptr[0]`부터 `ptr[length]`까지, 나머지는 `ptr[0]`부터 `ptr[length - 1]`까지 저장한다.
+*/
+typedef struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t kind;
+    uint32_t element_size;
+    uint64_t count;
+    uint8_t padding[40];
+} SnapshotHeader;
+
+/* 메모리에 불러온 스냅숏 파일을 나타내는 구조체. */
+typedef struct Snapshot {
+    SnapshotKind kind;
+    int count;
+    void *ptr;
+    size_t size;
+    bool is_mapped;
+    Allocator allocator;
+} Snapshot;
+
+/* 스택 `stack`의 스냅숏을 파일 `path`에 저장한다. */
+SNAPSHOT_DEF bool snapshot_save_stack(const char *path, Stack *stack);
+
+/* 이진 힙 `heap`의 스냅숏을 파일 `path`에 저장한다. */
+SNAPSHOT_DEF bool snapshot_save_binary_heap(const char *path, BinaryHeap *heap);
+
+#if SNAPSHOT_HAS_QUEUE
+/* 큐 `queue`의 스냅숏을 파일 `path`에 저장한다. */
+SNAPSHOT_DEF bool snapshot_save_queue(const char *path, Queue *queue);
+#endif
+
+/* 길이가 `count`인 정렬된 배열 `ptr`의 스냅숏을 파일 `path`에 저장한다. 배열이 정렬되어 있지 않으면 `false`를 반환한다. */
+SNAPSHOT_DEF bool snapshot_save_sorted_array(const char *path, const int *ptr, int count);
+
+/* 
+    스냅숏 파일 `path`를 메모리에 불러온다.
+    
+    - 가능하면 파일을 쓰기 시 복사 (copy-on-write) 방식으로 메모리에 매핑하므로, 
+      파일을 읽거나 값을 하나씩 해석하지 않고 곧바로 사용할 수 있다. 값을 바꾸어도 파일은 바뀌지 않는다.
+    - 파일 형식이나 버전이 맞지 않으면 `NULL`을 반환한다.
+*/
+SNAPSHOT_DEF Snapshot *snapshot_open(const char *path);
+
+/* 
+    스냅숏 `snapshot`에 할당된 메모리를 해제한다. 
+    
+    - 이 스냅숏으로 만든 자료 구조는 모두 먼저 해제해야 한다.
+*/
+SNAPSHOT_DEF void snapshot_close(Snapshot *snapshot);
+
+/* 
+    스냅숏 `snapshot`의 버퍼를 그대로 사용하는 스택을 생성한다.
+    
+    - 스택이 스냅숏에 저장된 것보다 더 커지면, 그때 처음으로 값을 새로 할당한 메모리로 복사한다.
+    - 스냅숏의 종류가 맞지 않으면 `NULL`을 반환한다.
+*/
+SNAPSHOT_DEF Stack *snapshot_load_stack(Snapshot *snapshot);
+
+/* 스냅숏 `snapshot`의 버퍼를 그대로 사용하는 이진 힙을 생성한다. */
+SNAPSHOT_DEF BinaryHeap *snapshot_load_binary_heap(Snapshot *snapshot);
+
+#if SNAPSHOT_HAS_QUEUE
+/* 스냅숏 `snapshot`의 버퍼를 그대로 사용하는 큐를 생성한다. */
+SNAPSHOT_DEF Queue *snapshot_load_queue(Snapshot *snapshot);
+#endif
+
+/* 스냅숏 `snapshot`에 저장된 정렬된 배열을 반환하고, 그 길이를 `count`에 저장한다. */
+SNAPSHOT_DEF int *snapshot_load_sorted_array(Snapshot *snapshot, int *count);
+
+#endif // `SNAPSHOT_H`
+
+#ifdef SNAPSHOT_IMPLEMENTATION
+
+/* 메모리 주소 `ptr`이 스냅숏 `snapshot`의 버퍼 안에 있는지 확인한다. */
+SNAPSHOT_DEF bool _snapshot_contains(Snapshot *snapshot, void *ptr) {
+    unsigned char *base = snapshot->ptr;
+    
+    return (unsigned char *) ptr >= base && (unsigned char *) ptr < base + snapshot->size;
+}
+
+/* 스냅숏 할당자로 `size` 바이트 크기의 메모리를 할당한다. */
+SNAPSHOT_DEF void *_snapshot_alloc(void *ctx, size_t size) {
+    (void) ctx;
+    
+    return calloc(1, size);
+}
+
+/* 스냅숏 할당자로 할당한 메모리 `ptr`의 크기를 `old_size`에서 `new_size`로 바꾼다. */
+SNAPSHOT_DEF void *_snapshot_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    if (!_snapshot_contains(ctx, ptr)) return realloc(ptr, new_size);
+    
+    // 스냅숏 안의 버퍼는 크기를 바꿀 수 없으므로, 새로 할당한 메모리로 값을 복사한다.
+    void *result = malloc(new_size);
+    
+    if (result != NULL) memcpy(result, ptr, (old_size < new_size) ? old_size : new_size);
+    
+    return result;
+}
+
+/* 스냅숏 할당자로 할당한 `size` 바이트 크기의 메모리 `ptr`을 해제한다. */
+SNAPSHOT_DEF void _snapshot_free(void *ctx, void *ptr, size_t size) {
+    (void) size;
+    
+    // 스냅숏 안의 버퍼는 `snapshot_close()`에서 한꺼번에 해제한다.
+    if (!_snapshot_contains(ctx, ptr)) free(ptr);
+}
+
+/* 자료 구조의 종류가 `kind`이고 값이 `count`개인 버퍼 `ptr`을 파일 `path`에 저장한다. */
+SNAPSHOT_DEF bool _snapshot_save(const char *path, SnapshotKind kind, const void *ptr, int count) {
+    if (path == NULL || (ptr == NULL && count > 0) || count < 0) return false;
+    
+    FILE *fp = fopen(path, "wb");
+    
+    if (fp == NULL) return false;
+    
+    SnapshotHeader header = { 0 };
+    
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.kind = kind;
+    header.element_size = sizeof(unsigned int);
+    header.count = count;
+    
+    bool result = fwrite(&header, sizeof(SnapshotHeader), 1, fp) == 1
+        && fwrite(ptr, sizeof(unsigned int), count, fp) == (size_t) count;
+    
+    return (fclose(fp) == 0) && result;
+}
+
+/* 스택 `stack`의 스냅숏을 파일 `path`에 저장한다. */
+SNAPSHOT_DEF bool snapshot_save_stack(const char *path, Stack *stack) {
+    if (stack == NULL) return false;
+    
+    return _snapshot_save(path, SNAPSHOT_KIND_STACK, stack->ptr, stack->length);
+}
+
+/* 이진 힙 `heap`의 스냅숏을 파일 `path`에 저장한다. */
+SNAPSHOT_DEF bool snapshot_save_binary_heap(const char *path, BinaryHeap *heap) {
+    if (heap == NULL) return false;
+    
+    // 이진 힙은 `ptr[1]`부터 값을 저장하므로, 사용하지 않는 `ptr[0]`도 함께 저장한다.
+    return _snapshot_save(path, SNAPSHOT_KIND_BINARY_HEAP, heap->ptr, heap->length + 1);
+}
+
+#if SNAPSHOT_HAS_QUEUE
+/* 큐 `queue`의 스냅숏을 파일 `path`에 저장한다. */
+SNAPSHOT_DEF bool snapshot_save_queue(const char *path, Queue *queue) {
+    if (queue == NULL) return false;
+    
+    return _snapshot_save(path, SNAPSHOT_KIND_QUEUE, queue->ptr, queue->length);
+}
+#endif
+
+/* 길이가 `count`인 정렬된 배열 `ptr`의 스냅숏을 파일 `path`에 저장한다. */
+SNAPSHOT_DEF bool snapshot_save_sorted_array(const char *path, const int *ptr, int count) {
+    if (ptr == NULL && count > 0) return false;
+    
+    for (int i = 1; i < count; i++)
+        if (ptr[i - 1] > ptr[i]) return false;
+    
+    return _snapshot_save(path, SNAPSHOT_KIND_SORTED_ARRAY, ptr, count);
+}
+
+/* 스냅숏 파일 `path`의 내용 전체를 `size` 바이트 크기의 메모리에 불러온다. */
+SNAPSHOT_DEF void *_snapshot_read(const char *path, size_t *size, bool *is_mapped) {
+#if ALLOCATOR_HAS_VM
+    int fd = open(path, O_RDONLY);
+    
+    if (fd < 0) return NULL;
+    
+    struct stat st;
+    
+    void *result = NULL;
+    
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        *size = (size_t) st.st_size;
+        
+        // 쓰기 시 복사 방식으로 매핑하므로, 값을 바꾸어도 파일에는 반영되지 않는다.
+        result = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        
+        if (result == MAP_FAILED) result = NULL;
+    }
+    
+    close(fd);
+    
+    *is_mapped = true;
+    
+    return result;
+#else
+    // 가상 메모리를 사용할 수 없으면, 파일의 내용 전체를 읽어 들인다.
+    FILE *fp = fopen(path, "rb");
+    
+    if (fp == NULL) return NULL;
+    
+    void *result = NULL;
+    
+    if (fseek(fp, 0, SEEK_END) == 0) {
+        long length = ftell(fp);
+        
+        if (length > 0 && fseek(fp, 0, SEEK_SET) == 0) {
+            *size = (size_t) length;
+            
+            result = malloc(*size);
+            
+            if (result != NULL && fread(result, 1, *size, fp) != *size) {
+                free(result);
+                
+                result = NULL;
+            }
+        }
+    }
+    
+    fclose(fp);
+    
+    *is_mapped = false;
+    
+    return result;
+#endif
+}
+
+/* 스냅숏 파일 `path`를 메모리에 불러온다. */
+SNAPSHOT_DEF Snapshot *snapshot_open(const char *path) {
+    if (path == NULL) return NULL;
+    
+    size_t size = 0;
+    bool is_mapped = false;
+    
+    void *ptr = _snapshot_read(path, &size, &is_mapped);
+    
+    if (ptr == NULL) return NULL;
+    
+    SnapshotHeader *header = ptr;
+    
+    // 헤더를 확인하고, 헤더에 적힌 개수만큼 값이 모두 들어 있는지 확인한다.
+    bool is_valid = size >= sizeof(SnapshotHeader) 
+        && header->magic == SNAPSHOT_MAGIC
+        && header->version == SNAPSHOT_VERSION
+        && header->kind >= SNAPSHOT_KIND_STACK && header->kind <= SNAPSHOT_KIND_SORTED_ARRAY
+        && header->element_size == sizeof(unsigned int)
+        && header->count <= (uint64_t) INT32_MAX
+        && header->count <= (size - sizeof(SnapshotHeader)) / sizeof(unsigned int);
+    
+    Snapshot *result = is_valid ? calloc(1, sizeof(Snapshot)) : NULL;
+    
+    if (result == NULL) {
+#if ALLOCATOR_HAS_VM
+        munmap(ptr, size);
+#else
+        free(ptr);
+#endif
+        
+        return NULL;
+    }
+    
+    result->kind = (SnapshotKind) header->kind;
+    result->count = (int) header->count;
+    result->ptr = ptr;
+    result->size = size;
+    result->is_mapped = is_mapped;
+    
+    result->allocator.ctx = result;
+    result->allocator.alloc = _snapshot_alloc;
+    result->allocator.realloc = _snapshot_realloc;
+    result->allocator.free = _snapshot_free;
+    
+    return result;
+}
+
+/* 스냅숏 `snapshot`에 할당된 메모리를 해제한다. */
+SNAPSHOT_DEF void snapshot_close(Snapshot *snapshot) {
+    if (snapshot == NULL) return;
+    
+#if ALLOCATOR_HAS_VM
+    if (snapshot->is_mapped) munmap(snapshot->ptr, snapshot->size);
+    else free(snapshot->ptr);
+#else
+    free(snapshot->ptr);
+#endif
+    
+    free(snapshot);
+}
+
+/* 스냅숏 `snapshot`에 저장된 값의 버퍼를 반환한다. */
+SNAPSHOT_DEF unsigned int *_snapshot_data(Snapshot *snapshot) {
+    return (unsigned int *) ((unsigned char *) snapshot->ptr + sizeof(SnapshotHeader));
+}
+
+/* 스냅숏 `snapshot`의 버퍼를 그대로 사용하는 스택을 생성한다. */
+SNAPSHOT_DEF Stack *snapshot_load_stack(Snapshot *snapshot) {
+    if (snapshot == NULL || snapshot->kind != SNAPSHOT_KIND_STACK) return NULL;
+    
+    Stack *result = allocator_alloc(&snapshot->allocator, sizeof(Stack));
+    
+    if (result == NULL) return NULL;
+    
+    result->allocator = snapshot->allocator;
+    
+    if (snapshot->count > 0) {
+        result->length = result->capacity = snapshot->count;
+        result->ptr = _snapshot_data(snapshot);
+    } else {
+        result->capacity = STACK_INLINE_CAPACITY;
+        result->ptr = result->inline_ptr;
+    }
+    
+    return result;
+}
+
+/* 스냅숏 `snapshot`의 버퍼를 그대로 사용하는 이진 힙을 생성한다. */
+SNAPSHOT_DEF BinaryHeap *snapshot_load_binary_heap(Snapshot *snapshot) {
+    if (snapshot == NULL || snapshot->kind != SNAPSHOT_KIND_BINARY_HEAP || snapshot->count < 1) return NULL;
+    
+    BinaryHeap *result = allocator_alloc(&snapshot->allocator, sizeof(BinaryHeap));
+    
+    if (result == NULL) return NULL;
+    
+    result->allocator = snapshot->allocator;
+    result->length = snapshot->count - 1;
+    result->capacity = snapshot->count;
+    result->ptr = _snapshot_data(snapshot);
+    
+    return result;
+}
+
+#if SNAPSHOT_HAS_QUEUE
+/* 스냅숏 `snapshot`의 버퍼를 그대로 사용하는 큐를 생성한다. */
+SNAPSHOT_DEF Queue *snapshot_load_queue(Snapshot *snapshot) {
+    if (snapshot == NULL || snapshot->kind != SNAPSHOT_KIND_QUEUE) return NULL;
+    
+    Queue *result = allocator_alloc(&snapshot->allocator, sizeof(Queue));
+    
+    if (result == NULL) return NULL;
+    
+    result->allocator = snapshot->allocator;
+    
+    if (snapshot->count > 0) {
+        result->length = result->capacity = snapshot->count;
+        result->ptr = _snapshot_data(snapshot);
+    } else {
+        result->capacity = QUEUE_INLINE_CAPACITY;
+        result->ptr = result->inline_ptr;
+    }
+    
+    return result;
+}
+#endif
+
+/* 스냅숏 `snapshot`에 저장된 정렬된 배열을 반환하고, 그 길이를 `count`에 저장한다. */
+SNAPSHOT_DEF int *snapshot_load_sorted_array(Snapshot *snapshot, int *count) {
+    if (snapshot == NULL || snapshot->kind != SNAPSHOT_KIND_SORTED_ARRAY) return NULL;
+    
+    if (count != NULL) *count = snapshot->count;
+    
+    return (int *) _snapshot_data(snapshot);
+}
+
+#endif // `SNAPSHOT_IMPLEMENTATION`
\ No newline at end of file
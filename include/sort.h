@@ -23,13 +23,82 @@
 #ifndef SORT_H
 #define SORT_H
 
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    
+    #define SORT_HAS_SSE2 1
+#else
+    #define SORT_HAS_SSE2 0
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    
+    #define SORT_HAS_SIMD_MERGE 1
+    
+    #define SORT_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define SORT_HAS_SIMD_MERGE 0
+#endif
+
+#include "allocator.h"
+#include "stats.h"
+#include "trace.h"
 
 #define SORT_DEF static
 
 #define SORT_MAX_ARRAY_LENGTH 20000000
 
+/* 합칠 두 배열의 길이의 합이 이 값 이상이면, 병합 정렬에 SIMD 병합 네트워크를 사용한다. */
+#define SORT_SIMD_MERGE_THRESHOLD 64
+
+/* 두 배열의 길이가 이 비율 이상 차이 나면, 집합 연산에 지수 탐색 (galloping)을 사용한다. */
+#define SORT_GALLOP_RATIO 32
+
+/* `sort_auto()`가 항상 삽입 정렬을 사용하는 배열의 최대 길이. */
+#define SORT_AUTO_INSERTION_THRESHOLD 32
+
+/* `sort_auto()`가 기수 정렬을 고려하기 시작하는 배열의 최소 길이. */
+#define SORT_AUTO_RADIX_THRESHOLD 65536
+
+/* `sort_auto()`가 계수 정렬에 사용하는 키 범위의 최대 크기. */
+#define SORT_AUTO_MAX_COUNTING_RANGE (1 << 22)
+
+/* `sort_auto()`가 중복 키의 비율과 역순 쌍의 비율을 추정할 때 사용하는 표본의 크기. */
+#define SORT_AUTO_SAMPLE_SIZE 128
+
+/* `sort_auto()`가 퀵 정렬 대신 병합 정렬을 사용하는 중복 키 비율의 최솟값. */
+#define SORT_AUTO_DUPLICATE_THRESHOLD 0.5f
+
+/* 정렬 엔진의 종류. */
+typedef enum SortEngine {
+    SORT_ENGINE_NONE,
+    SORT_ENGINE_INSERTION,
+    SORT_ENGINE_COUNTING,
+    SORT_ENGINE_RADIX,
+    SORT_ENGINE_MERGE,
+    SORT_ENGINE_QUICK,
+    SORT_ENGINE_SHELL
+} SortEngine;
+
+/* `sort_auto()`가 측정한 배열의 특성과, 그에 따라 사용한 정렬 엔진을 나타내는 구조체. */
+typedef struct SortDecision {
+    SortEngine engine;
+    int count;
+    int runs;
+    int min_value;
+    int max_value;
+    float inversion_rate;
+    float duplicate_rate;
+} SortDecision;
+
 /* 길이가 `count`인 배열 `ptr`을 선택 정렬한다. */
 SORT_DEF void selection_sort(int *ptr, int count);
 
@@ -42,12 +111,104 @@ SORT_DEF void shell_sort(int *ptr, int count);
 /* 길이가 `count`인 배열 `ptr`을 병합 정렬한다. */
 SORT_DEF void merge_sort(int *ptr, int count);
 
+/* 
+    메모리 할당자 `allocator`를 사용하여 길이가 `count`인 배열 `ptr`을 병합 정렬하고, 성공 여부를 반환한다.
+    
+    - 보조 배열을 할당하지 못하면 배열을 바꾸지 않고 `false`를 반환한다.
+*/
+SORT_DEF bool merge_sort_with_allocator(int *ptr, int count, const Allocator *allocator);
+
 /* 길이가 `count`인 배열 `ptr`을 퀵 정렬한다. */
 SORT_DEF void quick_sort(int *ptr, int count);
 
 /* 길이가 `count`인 정렬된 배열 `ptr`에서 `value`의 인덱스를 찾는다. */
 SORT_DEF int binary_search(int *ptr, int count, int value);
 
+/* 
+    길이가 `count`인 배열 `ptr`의 특성을 측정하여 알맞은 정렬 엔진을 고르고, 그 엔진으로 배열을 정렬한다.
+    
+    - 배열을 한 번 훑어 오름차순 구간 (run)의 개수와 키의 범위를 세고, 일부 항목만 뽑은 
+      표본으로 역순 쌍 (inversion)과 중복 키의 비율을 추정한다.
+    - 측정한 값과 실제로 사용한 정렬 엔진을 반환하므로, 그대로 기록해 둘 수 있다.
+*/
+SORT_DEF SortDecision sort_auto(int *ptr, int count);
+
+/* 정렬 엔진 `engine`의 이름을 반환한다. */
+SORT_DEF const char *sort_engine_name(SortEngine engine);
+
+/* 
+    길이가 `count`인 배열 `keys`를 정렬했을 때의 순서대로, 각 항목의 인덱스를 `indices`에 저장한다.
+    
+    - 같은 키를 가진 항목은 원래의 순서를 유지한다 (stable).
+    - 인자가 올바르지 않거나 메모리를 할당하지 못하면 `false`를 반환하며, 
+      이때 `indices`의 내용은 정의되지 않는다.
+*/
+SORT_DEF bool argsort(const int *keys, int count, int *indices);
+
+/* 
+    길이가 `count`인 64비트 키 배열 `keys`를 정렬했을 때의 순서대로, 각 항목의 인덱스를 `indices`에 저장한다.
+    
+    - 실패하면 `false`를 반환한다.
+*/
+SORT_DEF bool argsort64(const long long *keys, int count, int *indices);
+
+/* 
+    크기가 `size` 바이트인 레코드 `count`개의 배열 `records`를 각 레코드의 `key_offset` 위치에 있는 
+    `int` 키의 순서대로 정렬했을 때의 인덱스를 `indices`에 저장한다.
+    
+    - 실패하면 `false`를 반환한다.
+*/
+SORT_DEF bool argsort_records(const void *records, int count, size_t size, size_t key_offset, int *indices);
+
+/* 
+    크기가 `size` 바이트인 레코드 `count`개의 배열 `records`를 `records[indices[0]]`, 
+    `records[indices[1]]`, ...의 순서로 재배치한다.
+    
+    - 각 레코드는 한 번씩만 이동하고, `indices`는 원래의 값으로 복구된다.
+*/
+SORT_DEF void permute_apply(void *records, int count, size_t size, int *indices);
+
+/*
+    중복 없이 정렬된 배열 `a`와 `b`의 교집합을 `result`에 저장하고, 그 길이를 반환한다.
+    
+    - `result`에는 `a_count`와 `b_count` 중 작은 값만큼의 공간이 있어야 한다.
+    - `result`는 `a` 또는 `b`와 같은 배열이어도 된다.
+*/
+SORT_DEF int sorted_intersection(const int *a, int a_count, const int *b, int b_count, int *result);
+
+/* 
+    중복 없이 정렬된 배열 `a`와 `b`의 합집합을 `result`에 저장하고, 그 길이를 반환한다.
+    
+    - `result`에는 `a_count + b_count`만큼의 공간이 있어야 한다.
+    - 한 배열이 다른 배열보다 `SORT_GALLOP_RATIO`배 이상 길면 지수 탐색을 사용하고, 
+      그렇지 않으면 분기 없는 스칼라 병합을 사용한다 (SIMD 묶음 비교는 교집합과 차집합에만 사용한다).
+*/
+SORT_DEF int sorted_union(const int *a, int a_count, const int *b, int b_count, int *result);
+
+/* 
+    중복 없이 정렬된 배열 `a`와 `b`의 차집합 (`a - b`)을 `result`에 저장하고, 그 길이를 반환한다.
+    
+    - `result`에는 `a_count`만큼의 공간이 있어야 한다.
+*/
+SORT_DEF int sorted_difference(const int *a, int a_count, const int *b, int b_count, int *result);
+
+/* 
+    정렬된 배열 `a`와 `b`를 하나로 합쳐 `result`에 저장하고, 그 길이를 반환한다.
+    
+    - `result`에는 `a_count + b_count`만큼의 공간이 있어야 한다.
+    - 다른 집합 연산과 달리, 중복된 값도 그대로 남긴다.
+    - 합집합과 마찬가지로, 길이가 크게 차이 날 때만 지수 탐색을 사용한다.
+*/
+SORT_DEF int sorted_merge(const int *a, int a_count, const int *b, int b_count, int *result);
+
+/* 
+    중복 없이 정렬된 배열 `k`개 (`arrays[0..(k - 1)]`)의 교집합을 `result`에 저장하고, 그 길이를 반환한다.
+    
+    - `counts[i]`는 배열 `arrays[i]`의 길이를 나타낸다.
+    - `result`에는 가장 짧은 배열의 길이만큼의 공간이 있어야 한다.
+*/
+SORT_DEF int sorted_intersection_k(const int **arrays, const int *counts, int k, int *result);
+
 #endif // `SORT_H`
 
 #ifdef SORT_IMPLEMENTATION
@@ -82,10 +243,12 @@ SORT_DEF void selection_sort(int *ptr, int count) {
         
         // 배열에서 가장 작은 항목을 찾는다.
         for (int j = i + 1; j < count; j++) {
-            if (ptr[min_index] > ptr[j])
+            if (STATS_CMP(ptr[min_index] > ptr[j]))
                 min_index = j;
         }
         
+        STATS_COUNT(swaps);
+        
         int temp_value = ptr[i];
         
         ptr[i] = ptr[min_index];
@@ -113,7 +276,9 @@ SORT_DEF void insertion_sort(int *ptr, int count) {
     
     for (int i = 1; i < count; i++) {
         for (int j = i; j > 0; j--) {
-            if (ptr[j - 1] <= ptr[j]) break; 
+            if (STATS_CMP(ptr[j - 1] <= ptr[j])) break; 
+            
+            STATS_COUNT(swaps);
             
             int temp_value = ptr[j];
             
@@ -148,13 +313,17 @@ SORT_DEF void shell_sort(int *ptr, int count) {
         h_index = i;
     
     // `h`가 1이 될 때까지 배열을 h-정렬시킨다.
-    while (GAP_SEQUENCE[h_index] >= 1) {
+    while (h_index >= 0) {
         int h = GAP_SEQUENCE[h_index];
         
+        TRACE_BEGIN_IF(gap_pass, count >= TRACE_MIN_SPAN_SIZE);
+        
         // 배열의 매 `h`번째 항목을 부분적으로 삽입 정렬한다.
         for (int i = h; i < count; i++) {
             for (int j = i; j >= h; j -= h) {
-                if (ptr[j] > ptr[j - h]) break;
+                if (STATS_CMP(ptr[j] >= ptr[j - h])) break;
+                
+                STATS_COUNT(swaps);
                 
                 int temp_value = ptr[j];
             
@@ -163,32 +332,221 @@ SORT_DEF void shell_sort(int *ptr, int count) {
             }
         }
         
+        TRACE_END(gap_pass, "shell_sort_gap_pass");
+        
         h_index--;
     } 
 }
 
+/* 
+    정렬된 배열 `a[0..(a_count - 1)]`과 `b[0..(b_count - 1)]`을 분기 없이 하나로 합쳐 `result`에 저장한다.
+    
+    - `result`는 `b`와 겹칠 수 있지만, 그 경우 `result`가 `b`보다 앞에서 시작해야 한다.
+*/
+SORT_DEF void _merge_branchless(const int *a, int a_count, const int *b, int b_count, int *result) {
+    int i = 0, j = 0, k = 0;
+    
+    while (i < a_count && j < b_count) {
+        int a_value = a[i], b_value = b[j];
+        
+        // 비교 결과에 따라 분기하는 대신, 비교 결과를 그대로 인덱스에 더한다.
+        int take_a = STATS_CMP(a_value <= b_value);
+        
+        result[k++] = take_a ? a_value : b_value;
+        
+        i += take_a;
+        j += !take_a;
+    }
+    
+    while (i < a_count) result[k++] = a[i++];
+    while (j < b_count) result[k++] = b[j++];
+}
+
+#if SORT_HAS_SIMD_MERGE
+
+/* 바이토닉 (bitonic) 수열 `v`를 SSE4.1 명령어로 정렬한다. */
+SORT_TARGET("sse4.1") SORT_DEF __m128i _bitonic_sort4_sse41(__m128i v) {
+    __m128i t = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    
+    v = _mm_blend_epi16(_mm_min_epi32(v, t), _mm_max_epi32(v, t), 0xf0);
+    t = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    
+    return _mm_blend_epi16(_mm_min_epi32(v, t), _mm_max_epi32(v, t), 0xcc);
+}
+
+/* 바이토닉 수열 `v`를 AVX2 명령어로 정렬한다. */
+SORT_TARGET("avx2") SORT_DEF __m256i _bitonic_sort8_avx2(__m256i v) {
+    __m256i t = _mm256_permute2x128_si256(v, v, 0x01);
+    
+    v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xf0);
+    t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    
+    v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xcc);
+    t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    
+    return _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xaa);
+}
+
+/* 
+    보조 배열의 `aux_ptr[*i..mid]`와 원래 배열의 `ptr[*j..high]`를 4개씩 묶어 `ptr[*k..]`에 합치고, 
+    아직 내보내지 않은 가장 큰 항목 4개를 `carry`에 저장한다.
+*/
+SORT_TARGET("sse4.1") SORT_DEF void _merge_two_arrays_sse41(
+    int *ptr, const int *aux_ptr, 
+    int *i, int mid, int *j, int high, int *k, 
+    int *carry
+) {
+    __m128i a = _mm_loadu_si128((const __m128i *) &aux_ptr[*i]);
+    __m128i b = _mm_loadu_si128((const __m128i *) &ptr[*j]);
+    
+    *i += 4, *j += 4;
+    
+    for (;;) {
+        /*
+            한쪽 묶음을 뒤집어 이어 붙이면 바이토닉 수열이 되므로, 두 묶음의 최솟값과 최댓값을 
+            구하면 작은 항목 4개와 큰 항목 4개로 나뉜다.
+        */
+        
+        b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 1, 2, 3));
+        
+        __m128i low_half = _bitonic_sort4_sse41(_mm_min_epi32(a, b));
+        __m128i high_half = _bitonic_sort4_sse41(_mm_max_epi32(a, b));
+        
+        STATS_ADD(comparisons, 12);
+        
+        _mm_storeu_si128((__m128i *) &ptr[*k], low_half);
+        
+        *k += 4;
+        
+        a = high_half;
+        
+        if (*i + 4 > mid + 1 || *j + 4 > high + 1) break;
+        
+        // 다음 항목이 더 작은 쪽의 묶음을 꺼내야, 큰 항목 4개가 먼저 내보내지지 않는다.
+        if (STATS_CMP(aux_ptr[*i] <= ptr[*j])) {
+            b = _mm_loadu_si128((const __m128i *) &aux_ptr[*i]);
+            
+            *i += 4;
+        } else {
+            b = _mm_loadu_si128((const __m128i *) &ptr[*j]);
+            
+            *j += 4;
+        }
+    }
+    
+    _mm_storeu_si128((__m128i *) carry, a);
+}
+
+/* 
+    보조 배열의 `aux_ptr[*i..mid]`와 원래 배열의 `ptr[*j..high]`를 8개씩 묶어 `ptr[*k..]`에 합치고, 
+    아직 내보내지 않은 가장 큰 항목 8개를 `carry`에 저장한다.
+*/
+SORT_TARGET("avx2") SORT_DEF void _merge_two_arrays_avx2(
+    int *ptr, const int *aux_ptr, 
+    int *i, int mid, int *j, int high, int *k, 
+    int *carry
+) {
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    
+    __m256i a = _mm256_loadu_si256((const __m256i *) &aux_ptr[*i]);
+    __m256i b = _mm256_loadu_si256((const __m256i *) &ptr[*j]);
+    
+    *i += 8, *j += 8;
+    
+    for (;;) {
+        b = _mm256_permutevar8x32_epi32(b, reverse);
+        
+        __m256i low_half = _bitonic_sort8_avx2(_mm256_min_epi32(a, b));
+        __m256i high_half = _bitonic_sort8_avx2(_mm256_max_epi32(a, b));
+        
+        STATS_ADD(comparisons, 32);
+        
+        _mm256_storeu_si256((__m256i *) &ptr[*k], low_half);
+        
+        *k += 8;
+        
+        a = high_half;
+        
+        if (*i + 8 > mid + 1 || *j + 8 > high + 1) break;
+        
+        if (STATS_CMP(aux_ptr[*i] <= ptr[*j])) {
+            b = _mm256_loadu_si256((const __m256i *) &aux_ptr[*i]);
+            
+            *i += 8;
+        } else {
+            b = _mm256_loadu_si256((const __m256i *) &ptr[*j]);
+            
+            *j += 8;
+        }
+    }
+    
+    _mm256_storeu_si256((__m256i *) carry, a);
+}
+
+#endif
+
 /* 배열 `ptr`의 부분 배열 `ptr[low..mid]`과 `ptr[(mid + 1)..high]`를 하나로 합친다. */
 SORT_DEF void _merge_two_arrays(int *ptr, int *aux_ptr, int low, int mid, int high) {
-    int i = low, j = mid + 1;
+    // 두 부분 배열이 이미 순서대로 놓여 있으면, 합칠 필요가 없다.
+    if (STATS_CMP(ptr[mid] <= ptr[mid + 1])) return;
+    
+    TRACE_BEGIN_IF(merge, high - low + 1 >= TRACE_MIN_SPAN_SIZE);
+    
+    int i = low, j = mid + 1, k = low;
+    
+    /*
+        왼쪽 절반만 보조 배열로 복사한다. 합친 결과를 원래 배열의 앞에서부터 채워 나가면, 
+        아직 읽지 않은 오른쪽 절반의 항목을 덮어쓰는 일은 생기지 않는다.
+    */
     
-    for (int k = low; k <= high; k++)
-        aux_ptr[k] = ptr[k];
+    memcpy(&aux_ptr[low], &ptr[low], (mid - low + 1) * sizeof(int));
     
-    for (int k = low; k <= high; k++) {
+    STATS_ADD(moves, (mid - low + 1) + (high - low + 1));
+    
+#if SORT_HAS_SIMD_MERGE
+    if (mid - low + 1 >= 8 && high - mid >= 8 && high - low + 1 >= SORT_SIMD_MERGE_THRESHOLD) {
+        int carry[8], lanes = 0;
+        
+        if (__builtin_cpu_supports("avx2")) {
+            _merge_two_arrays_avx2(ptr, aux_ptr, &i, mid, &j, high, &k, carry);
+            
+            lanes = 8;
+        } else if (__builtin_cpu_supports("sse4.1")) {
+            _merge_two_arrays_sse41(ptr, aux_ptr, &i, mid, &j, high, &k, carry);
+            
+            lanes = 4;
+        }
+        
         /*
-            왼쪽 절반에 남은 항목이 존재하거나 왼쪽 절반의 항목이 오른쪽 절반의 항목보다 작은 경우,
-            왼쪽 절반에서 항목 한 개를 꺼내고, 그렇지 않을 경우 오른쪽 절반에서 항목 한 개를 꺼낸다.
+            `carry`에 남은 항목을 두 부분 배열 중 더 짧은 쪽에 되돌려 넣는다. 양쪽 모두 
+            이미 꺼낸 묶음의 자리가 비어 있으므로, 그 자리에서 바로 합칠 수 있다.
         */
         
-        if (i <= mid && (j > high || aux_ptr[i] <= aux_ptr[j])) ptr[k] = aux_ptr[i++];
-        else ptr[k] = aux_ptr[j++];
+        if (lanes > 0) {
+            if (mid + 1 - i <= high + 1 - j) {
+                _merge_branchless(carry, lanes, &aux_ptr[i], mid + 1 - i, &aux_ptr[i - lanes]);
+                
+                i -= lanes;
+            } else {
+                _merge_branchless(carry, lanes, &ptr[j], high + 1 - j, &ptr[j - lanes]);
+                
+                j -= lanes;
+            }
+        }
     }
+#endif
+    
+    _merge_branchless(&aux_ptr[i], mid + 1 - i, &ptr[j], high + 1 - j, &ptr[k]);
+    
+    TRACE_END(merge, "merge_two_arrays");
 }
 
 /* 배열 `ptr`의 부분 배열 `ptr[low..high]`를 병합 정렬한다. */
 SORT_DEF void _merge_sort_helper(int *ptr, int *aux_ptr, int low, int high) {
     if (low >= high) return;
     
+    STATS_ENTER();
+    
     int mid = (low + high) / 2;
     
     // `ptr[low..(mid + 1)]`과 `ptr[(mid + 1)..high]`를 정렬한다.
@@ -197,6 +555,8 @@ SORT_DEF void _merge_sort_helper(int *ptr, int *aux_ptr, int low, int high) {
     
     // 정렬된 두 배열을 하나로 합친다.
     _merge_two_arrays(ptr, aux_ptr, low, mid, high);
+    
+    STATS_LEAVE();
 }
  
 /* 길이가 `count`인 배열 `ptr`을 병합 정렬한다. */
@@ -215,37 +575,57 @@ SORT_DEF void merge_sort(int *ptr, int count) {
           정렬을 위해 `N`에 비례하는 메모리 공간을 추가적으로 사용한다.
     */
     
-    int *aux_ptr = calloc(count, sizeof(int));
+    // 보조 배열을 할당하지 못하면, 추가 메모리가 필요 없는 셸 정렬로 대신 정렬한다.
+    if (!merge_sort_with_allocator(ptr, count, NULL)) shell_sort(ptr, count);
+}
+
+/* 메모리 할당자 `allocator`를 사용하여 길이가 `count`인 배열 `ptr`을 병합 정렬한다. */
+SORT_DEF bool merge_sort_with_allocator(int *ptr, int count, const Allocator *allocator) {
+    if (ptr == NULL || count < 0 || count > SORT_MAX_ARRAY_LENGTH) return false;
+    
+    if (count <= 1) return true;
     
-    for (int i = 0; i < count; i++)
-        aux_ptr[i] = ptr[i];
+    int *aux_ptr = allocator_alloc(allocator, count * sizeof(int));
+    
+    if (aux_ptr == NULL) return false;
     
     _merge_sort_helper(ptr, aux_ptr, 0, count - 1);
     
-    free(aux_ptr);
+    allocator_free(allocator, aux_ptr, count * sizeof(int));
+    
+    return true;
 }
 
 /* 배열 `ptr`의 부분 배열 `ptr[low..high]`를 적절하게 분할하고, 분할 기준 항목의 인덱스를 반환한다. */
 SORT_DEF int _quick_sort_partition(int *ptr, int low, int high) {
-    int i = low, j = high;
+    TRACE_BEGIN_IF(partition, high - low + 1 >= TRACE_MIN_SPAN_SIZE);
+    
+    int i = low, j = high + 1;
     
     for (;;) {
-        do { i++; } while (ptr[i] < ptr[low]);
-        do { j--; } while (ptr[j] > ptr[low]);
+        // 분할 기준 항목보다 크거나 같은 항목을 왼쪽에서, 작거나 같은 항목을 오른쪽에서 찾는다.
+        do { i++; } while (i < high && STATS_CMP(ptr[i] < ptr[low]));
+        do { j--; } while (j > low && STATS_CMP(ptr[j] > ptr[low]));
         
         if (i >= j) break;
         
+        STATS_COUNT(swaps);
+        
         int temp_value = ptr[i];
         
         ptr[i] = ptr[j];
         ptr[j] = temp_value;
     }
     
+    STATS_COUNT(swaps);
+    
     int temp_value = ptr[low];
         
     ptr[low] = ptr[j];
     ptr[j] = temp_value;
     
+    TRACE_END(partition, "quick_sort_partition");
+    
     return j;
 }
 
@@ -253,10 +633,14 @@ SORT_DEF int _quick_sort_partition(int *ptr, int low, int high) {
 SORT_DEF void _quick_sort_helper(int *ptr, int low, int high) {
     if (low >= high) return;
     
+    STATS_ENTER();
+    
     int mid = _quick_sort_partition(ptr, low, high);
     
     _quick_sort_helper(ptr, low, mid - 1);
     _quick_sort_helper(ptr, mid + 1, high);
+    
+    STATS_LEAVE();
 }
 
 /* 길이가 `count`인 배열 `ptr`을 퀵 정렬한다. */
@@ -286,12 +670,823 @@ SORT_DEF int binary_search(int *ptr, int count, int value) {
     while (low <= high) {
         int mid = (low + high) / 2;
         
-        if (ptr[mid] < value) low = mid + 1;
-        else if (ptr[mid] > value) high = mid - 1;
+        if (STATS_CMP(ptr[mid] < value)) low = mid + 1;
+        else if (STATS_CMP(ptr[mid] > value)) high = mid - 1;
         else return mid;
     }
     
     return -1;
 }
 
+/* 
+    길이가 `count`인 배열 `ptr`을 각 항목의 `low_byte`번째 바이트부터 `high_byte - 1`번째 바이트까지를 
+    기준으로 기수 정렬한다.
+*/
+SORT_DEF void _radix_sort_u64(uint64_t *ptr, uint64_t *aux_ptr, int count, int low_byte, int high_byte) {
+    /*
+        [기수 정렬의 동작 과정]
+        
+        1. 각 항목의 가장 낮은 자리의 바이트 값마다 항목의 개수를 센다.
+        2. 항목의 개수로 각 바이트 값이 들어갈 위치를 계산하고, 원래의 순서를 유지하며 항목을 옮긴다.
+        3. 이러한 작업을 가장 높은 자리의 바이트까지 반복한다.
+        
+        [기수 정렬의 성능]
+        
+        - 기수 정렬은 항목끼리 비교하지 않으며, 바이트 하나마다 배열을 두 번씩 읽는다.
+        - 따라서 기수 정렬의 시간 복잡도는 키의 바이트 수를 `W`라고 할 때 `O(W * N)`이다.
+    */
+    
+    uint64_t *src = ptr, *dst = aux_ptr;
+    
+    for (int byte = low_byte; byte < high_byte; byte++) {
+        int shift = 8 * byte;
+        int counts[257] = { 0 };
+        
+        for (int i = 0; i < count; i++)
+            counts[((src[i] >> shift) & 0xff) + 1]++;
+        
+        // 모든 항목의 바이트 값이 같으면, 이 자리는 건너뛴다.
+        if (counts[((src[0] >> shift) & 0xff) + 1] == count) continue;
+        
+        for (int i = 1; i < 257; i++)
+            counts[i] += counts[i - 1];
+        
+        for (int i = 0; i < count; i++)
+            dst[counts[(src[i] >> shift) & 0xff]++] = src[i];
+        
+        STATS_ADD(moves, count);
+        
+        uint64_t *temp_ptr = src;
+        
+        src = dst;
+        dst = temp_ptr;
+    }
+    
+    if (src != ptr) memcpy(ptr, src, count * sizeof(uint64_t));
+}
+
+/* 64비트 키와 인덱스의 쌍을 나타내는 구조체. */
+typedef struct _SortPair {
+    uint64_t key;
+    int index;
+} _SortPair;
+
+/* 길이가 `count`인 쌍의 배열 `ptr`을 키를 기준으로 기수 정렬한다. */
+SORT_DEF void _radix_sort_pairs(_SortPair *ptr, _SortPair *aux_ptr, int count) {
+    _SortPair *src = ptr, *dst = aux_ptr;
+    
+    for (int byte = 0; byte < 8; byte++) {
+        int shift = 8 * byte;
+        int counts[257] = { 0 };
+        
+        for (int i = 0; i < count; i++)
+            counts[((src[i].key >> shift) & 0xff) + 1]++;
+        
+        if (counts[((src[0].key >> shift) & 0xff) + 1] == count) continue;
+        
+        for (int i = 1; i < 257; i++)
+            counts[i] += counts[i - 1];
+        
+        for (int i = 0; i < count; i++)
+            dst[counts[(src[i].key >> shift) & 0xff]++] = src[i];
+        
+        STATS_ADD(moves, count);
+        
+        _SortPair *temp_ptr = src;
+        
+        src = dst;
+        dst = temp_ptr;
+    }
+    
+    if (src != ptr) memcpy(ptr, src, count * sizeof(_SortPair));
+}
+
+/* 길이가 `count`인 키 배열을 정렬했을 때의 인덱스를 `indices`에 저장한다. */
+SORT_DEF bool _argsort_packed(const void *keys, int count, size_t stride, int *indices) {
+    /*
+        부호를 뒤집은 32비트 키를 상위 32비트에, 인덱스를 하위 32비트에 담은 64비트 정수를
+        만들면, 이 정수를 상위 4바이트만 기수 정렬하는 것으로 키와 인덱스를 함께 옮길 수 있다.
+    */
+    
+    if (count == 0) return true;
+    
+    uint64_t *ptr = allocator_alloc(NULL, 2 * (size_t) count * sizeof(uint64_t));
+    
+    if (ptr == NULL) return false;
+    
+    const unsigned char *key_ptr = keys;
+    
+    for (int i = 0; i < count; i++, key_ptr += stride) {
+        int key;
+        
+        memcpy(&key, key_ptr, sizeof(int));
+        
+        ptr[i] = ((uint64_t) ((uint32_t) key ^ 0x80000000U) << 32) | (uint32_t) i;
+    }
+    
+    _radix_sort_u64(ptr, ptr + count, count, 4, 8);
+    
+    for (int i = 0; i < count; i++)
+        indices[i] = (int) (uint32_t) ptr[i];
+    
+    allocator_free(NULL, ptr, 2 * (size_t) count * sizeof(uint64_t));
+    
+    return true;
+}
+
+/* 길이가 `count`인 배열 `keys`를 정렬했을 때의 순서대로, 각 항목의 인덱스를 `indices`에 저장한다. */
+SORT_DEF bool argsort(const int *keys, int count, int *indices) {
+    if (((keys == NULL || indices == NULL) && count > 0) || count < 0 || count > SORT_MAX_ARRAY_LENGTH) 
+        return false;
+    
+    return _argsort_packed(keys, count, sizeof(int), indices);
+}
+
+/* 길이가 `count`인 64비트 키 배열 `keys`를 정렬했을 때의 순서대로, 각 항목의 인덱스를 `indices`에 저장한다. */
+SORT_DEF bool argsort64(const long long *keys, int count, int *indices) {
+    if (((keys == NULL || indices == NULL) && count > 0) || count < 0 || count > SORT_MAX_ARRAY_LENGTH) 
+        return false;
+    
+    if (count == 0) return true;
+    
+    _SortPair *ptr = allocator_alloc(NULL, 2 * (size_t) count * sizeof(_SortPair));
+    
+    if (ptr == NULL) return false;
+    
+    for (int i = 0; i < count; i++) {
+        ptr[i].key = (uint64_t) keys[i] ^ 0x8000000000000000ULL;
+        ptr[i].index = i;
+    }
+    
+    _radix_sort_pairs(ptr, ptr + count, count);
+    
+    for (int i = 0; i < count; i++)
+        indices[i] = ptr[i].index;
+    
+    allocator_free(NULL, ptr, 2 * (size_t) count * sizeof(_SortPair));
+    
+    return true;
+}
+
+/* 
+    크기가 `size` 바이트인 레코드 `count`개의 배열 `records`를 각 레코드의 `key_offset` 위치에 있는 
+    `int` 키의 순서대로 정렬했을 때의 인덱스를 `indices`에 저장한다.
+*/
+SORT_DEF bool argsort_records(const void *records, int count, size_t size, size_t key_offset, int *indices) {
+    if (((records == NULL || indices == NULL) && count > 0) || count < 0 || count > SORT_MAX_ARRAY_LENGTH) 
+        return false;
+    
+    if (size < key_offset + sizeof(int)) return false;
+    
+    if (count == 0) return true;
+    
+    return _argsort_packed((const unsigned char *) records + key_offset, count, size, indices);
+}
+
+/* 크기가 `size` 바이트인 레코드 `count`개의 배열 `records`를 `indices`의 순서대로 재배치한다. */
+SORT_DEF void permute_apply(void *records, int count, size_t size, int *indices) {
+    /*
+        `i`번째 자리에 와야 하는 레코드는 `indices[i]`번째 레코드이므로, 각 순환 (cycle)의 
+        첫 번째 레코드만 임시 공간에 옮겨 두고 나머지 레코드를 한 칸씩 당겨 오면 된다.
+        이미 옮긴 자리는 `indices`의 값을 비트 반전하여 표시해 두고, 마지막에 복구한다.
+    */
+    
+    if (records == NULL || indices == NULL || count <= 0 || size == 0) return;
+    
+    unsigned char buffer[256];
+    unsigned char *temp_ptr = (size <= sizeof(buffer)) ? buffer : allocator_alloc(NULL, size);
+    
+    if (temp_ptr == NULL) return;
+    
+    unsigned char *ptr = records;
+    
+    for (int i = 0; i < count; i++) {
+        if (indices[i] < 0 || indices[i] == i) continue;
+        
+        memcpy(temp_ptr, ptr + i * size, size);
+        
+        int j = i;
+        
+        for (;;) {
+            int k = indices[j];
+            
+            indices[j] = ~k;
+            
+            STATS_COUNT(moves);
+            
+            if (k == i) {
+                memcpy(ptr + j * size, temp_ptr, size);
+                
+                break;
+            }
+            
+            memcpy(ptr + j * size, ptr + k * size, size);
+            
+            j = k;
+        }
+    }
+    
+    for (int i = 0; i < count; i++)
+        if (indices[i] < 0) indices[i] = ~indices[i];
+    
+    if (temp_ptr != buffer) allocator_free(NULL, temp_ptr, size);
+}
+
+/* 
+    길이가 `count`인 배열 `ptr`을 삽입 정렬하되, 항목을 `budget`번보다 많이 이동해야 하면 
+    정렬을 멈추고 `false`를 반환한다.
+*/
+SORT_DEF bool _insertion_sort_bounded(int *ptr, int count, long long budget) {
+    for (int i = 1; i < count; i++) {
+        int value = ptr[i], j = i;
+        
+        // 항목을 매번 맞바꾸는 대신, 더 큰 항목을 오른쪽으로 한 칸씩 민다.
+        while (j > 0 && STATS_CMP(ptr[j - 1] > value)) {
+            ptr[j] = ptr[j - 1];
+            
+            j--;
+        }
+        
+        ptr[j] = value;
+        
+        STATS_ADD(moves, i - j);
+        
+        if ((budget -= i - j) < 0) return false;
+    }
+    
+    return true;
+}
+
+/* 길이가 `count`이고 모든 항목이 `min_value` 이상 `max_value` 이하인 배열 `ptr`을 계수 정렬한다. */
+SORT_DEF bool _counting_sort(int *ptr, int count, int min_value, int max_value) {
+    /*
+        [계수 정렬의 동작 과정]
+        
+        1. 키의 범위 안의 각 값마다 그 값을 가진 항목의 개수를 센다.
+        2. 작은 값부터 차례대로, 센 개수만큼 그 값을 배열에 다시 쓴다.
+        
+        [계수 정렬의 성능]
+        
+        - 계수 정렬은 항목끼리 비교하지 않으며, 키의 범위의 크기를 `K`라고 할 때 
+          시간 복잡도는 `O(N + K)`이다.
+    */
+    
+    size_t range = (size_t) ((long long) max_value - min_value + 1);
+    
+    int *counts = allocator_alloc(NULL, range * sizeof(int));
+    
+    if (counts == NULL) return false;
+    
+    for (int i = 0; i < count; i++)
+        counts[ptr[i] - min_value]++;
+    
+    for (size_t i = 0, k = 0; i < range; i++) {
+        int value = (int) (min_value + (long long) i);
+        
+        for (int j = 0; j < counts[i]; j++)
+            ptr[k++] = value;
+    }
+    
+    STATS_ADD(moves, count);
+    
+    allocator_free(NULL, counts, range * sizeof(int));
+    
+    return true;
+}
+
+/* 길이가 `count`인 배열 `ptr`을 기수 정렬한다. */
+SORT_DEF bool _radix_sort_int(int *ptr, int count) {
+    uint32_t *aux_ptr = allocator_alloc(NULL, count * sizeof(uint32_t));
+    
+    if (aux_ptr == NULL) return false;
+    
+    uint32_t *src = (uint32_t *) ptr, *dst = aux_ptr;
+    
+    // 부호 비트를 뒤집으면, 부호 있는 정수의 순서와 부호 없는 정수의 순서가 같아진다.
+    for (int i = 0; i < count; i++)
+        src[i] ^= 0x80000000U;
+    
+    for (int byte = 0; byte < 4; byte++) {
+        int shift = 8 * byte;
+        int counts[257] = { 0 };
+        
+        for (int i = 0; i < count; i++)
+            counts[((src[i] >> shift) & 0xff) + 1]++;
+        
+        // 모든 항목의 바이트 값이 같으면, 이 자리는 건너뛴다.
+        if (counts[((src[0] >> shift) & 0xff) + 1] == count) continue;
+        
+        for (int i = 1; i < 257; i++)
+            counts[i] += counts[i - 1];
+        
+        for (int i = 0; i < count; i++)
+            dst[counts[(src[i] >> shift) & 0xff]++] = src[i];
+        
+        STATS_ADD(moves, count);
+        
+        uint32_t *temp_ptr = src;
+        
+        src = dst;
+        dst = temp_ptr;
+    }
+    
+    if (src != (uint32_t *) ptr) memcpy(ptr, src, count * sizeof(uint32_t));
+    
+    for (int i = 0; i < count; i++)
+        ptr[i] = (int) ((uint32_t) ptr[i] ^ 0x80000000U);
+    
+    allocator_free(NULL, aux_ptr, count * sizeof(uint32_t));
+    
+    return true;
+}
+
+/* 길이가 `count`인 배열 `ptr`의 특성을 측정하여 알맞은 정렬 엔진을 고르고, 그 엔진으로 배열을 정렬한다. */
+SORT_DEF SortDecision sort_auto(int *ptr, int count) {
+    /*
+        [정렬 엔진의 선택 기준]
+        
+        1. 배열이 짧으면 메모리를 할당하지 않는 삽입 정렬을 사용한다.
+        2. 배열이 이미 정렬되어 있으면 아무것도 하지 않는다.
+        3. 키의 범위가 배열의 길이에 비해 좁으면 계수 정렬을 사용한다.
+        4. 오름차순 구간이 매우 적으면 (거의 정렬되어 있으면) 삽입 정렬을 사용한다. 
+           단, 항목을 너무 많이 옮겨야 하면 병합 정렬로 바꾼다.
+        5. 배열이 길면 기수 정렬을 사용한다.
+        6. 배열이 무작위에 가까우면 퀵 정렬을, 그렇지 않으면 (부분적으로 정렬되어 있거나 
+           역순에 가까우면) 분할이 한쪽으로 치우칠 수 있으므로 병합 정렬을 사용한다.
+           표본에서 중복 키의 비율이 `SORT_AUTO_DUPLICATE_THRESHOLD` 이상이면, 첫 번째 항목을 
+           분할 기준으로 삼는 퀵 정렬이 같은 키를 반복해서 교환하므로 역시 병합 정렬을 사용한다.
+    */
+    
+    SortDecision result = { SORT_ENGINE_NONE, count, 0, 0, 0, 0.0f, 0.0f };
+    
+    if (ptr == NULL || count <= 1 || count > SORT_MAX_ARRAY_LENGTH) return result;
+    
+    result.runs = 1;
+    result.min_value = result.max_value = ptr[0];
+    
+    // 배열을 한 번 훑어 오름차순 구간의 개수와 키의 범위를 센다.
+    for (int i = 1; i < count; i++) {
+        result.runs += (ptr[i - 1] > ptr[i]);
+        
+        if (result.min_value > ptr[i]) result.min_value = ptr[i];
+        if (result.max_value < ptr[i]) result.max_value = ptr[i];
+    }
+    
+    // 일정한 간격으로 뽑은 표본을 삽입 정렬하면서, 역순 쌍과 중복 키의 개수를 센다.
+    int sample[SORT_AUTO_SAMPLE_SIZE];
+    
+    int sample_count = (count < SORT_AUTO_SAMPLE_SIZE) ? count : SORT_AUTO_SAMPLE_SIZE;
+    
+    for (int i = 0; i < sample_count; i++)
+        sample[i] = ptr[(int) ((long long) i * count / sample_count)];
+    
+    long long inversions = 0;
+    
+    for (int i = 1; i < sample_count; i++) {
+        int value = sample[i], j = i;
+        
+        for (; j > 0 && sample[j - 1] > value; j--)
+            sample[j] = sample[j - 1];
+        
+        sample[j] = value;
+        
+        inversions += i - j;
+    }
+    
+    int duplicates = 0;
+    
+    for (int i = 1; i < sample_count; i++)
+        duplicates += (sample[i - 1] == sample[i]);
+    
+    result.inversion_rate = (float) inversions / ((long long) sample_count * (sample_count - 1) / 2);
+    result.duplicate_rate = (float) duplicates / (sample_count - 1);
+    
+    long long range = (long long) result.max_value - result.min_value + 1;
+    
+    if (count <= SORT_AUTO_INSERTION_THRESHOLD) {
+        result.engine = SORT_ENGINE_INSERTION;
+    } else if (result.runs == 1) {
+        result.engine = SORT_ENGINE_NONE;
+    } else if (range <= 2LL * count && range <= SORT_AUTO_MAX_COUNTING_RANGE) {
+        result.engine = SORT_ENGINE_COUNTING;
+    } else if (result.runs - 1 <= count / 64) {
+        result.engine = SORT_ENGINE_INSERTION;
+    } else if (count >= SORT_AUTO_RADIX_THRESHOLD) {
+        result.engine = SORT_ENGINE_RADIX;
+    } else if (result.inversion_rate >= 0.25f && result.inversion_rate <= 0.75f && 4 * result.runs >= count 
+        && result.duplicate_rate < SORT_AUTO_DUPLICATE_THRESHOLD) {
+        result.engine = SORT_ENGINE_QUICK;
+    } else {
+        result.engine = SORT_ENGINE_MERGE;
+    }
+    
+    switch (result.engine) {
+        case SORT_ENGINE_INSERTION:
+            // 거의 정렬된 배열이라도 멀리 떨어진 항목이 많으면, 병합 정렬로 마저 정렬한다.
+            if (!_insertion_sort_bounded(ptr, count, (count <= SORT_AUTO_INSERTION_THRESHOLD) ? LLONG_MAX : 8LL * count)) 
+                result.engine = SORT_ENGINE_MERGE;
+            
+            break;
+        
+        case SORT_ENGINE_COUNTING:
+            /*
+                메모리를 할당하지 못하면, 추가 메모리가 필요 없는 셸 정렬을 대신 사용한다. 
+                퀵 정렬은 정렬된 배열에서 `O(N^2)`의 시간과 `O(N)` 깊이의 재귀 호출이 필요하므로 
+                사용하지 않는다.
+            */
+            if (!_counting_sort(ptr, count, result.min_value, result.max_value)) 
+                result.engine = SORT_ENGINE_SHELL;
+            
+            break;
+        
+        case SORT_ENGINE_RADIX:
+            if (!_radix_sort_int(ptr, count)) result.engine = SORT_ENGINE_SHELL;
+            
+            break;
+        
+        default:
+            break;
+    }
+    
+    if (result.engine == SORT_ENGINE_MERGE && !merge_sort_with_allocator(ptr, count, NULL)) 
+        result.engine = SORT_ENGINE_SHELL;
+    
+    if (result.engine == SORT_ENGINE_QUICK) quick_sort(ptr, count);
+    else if (result.engine == SORT_ENGINE_SHELL) shell_sort(ptr, count);
+    
+    return result;
+}
+
+/* 정렬 엔진 `engine`의 이름을 반환한다. */
+SORT_DEF const char *sort_engine_name(SortEngine engine) {
+    switch (engine) {
+        case SORT_ENGINE_NONE:
+            return "none";
+        
+        case SORT_ENGINE_INSERTION:
+            return "insertion";
+        
+        case SORT_ENGINE_COUNTING:
+            return "counting";
+        
+        case SORT_ENGINE_RADIX:
+            return "radix";
+        
+        case SORT_ENGINE_MERGE:
+            return "merge";
+        
+        case SORT_ENGINE_QUICK:
+            return "quick";
+        
+        case SORT_ENGINE_SHELL:
+            return "shell";
+        
+        default:
+            return "unknown";
+    }
+}
+
+/* 정렬된 배열 `ptr[low..(count - 1)]`에서 `value` 이상인 첫 번째 항목의 인덱스를 지수 탐색으로 찾는다. */
+SORT_DEF int _gallop_lower_bound(const int *ptr, int low, int count, int value) {
+    int high = low;
+    
+    // 탐색 범위를 1, 2, 4, 8, ...칸씩 넓혀 가며 `value` 이상인 항목을 찾는다.
+    for (int step = 1; high < count && STATS_CMP(ptr[high] < value); step *= 2) {
+        low = high + 1;
+        high += step;
+    }
+    
+    if (high > count) high = count;
+    
+    // 좁혀진 범위 `ptr[low..(high - 1)]`에서 이진 탐색을 한다.
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        
+        if (STATS_CMP(ptr[mid] < value)) low = mid + 1;
+        else high = mid;
+    }
+    
+    return low;
+}
+
+/* 
+    정렬된 짧은 배열 `s`의 각 항목을 긴 배열 `l`에서 지수 탐색으로 찾고, 그 사이에 있는 `l`의 항목을 
+    한 번에 복사하면서 두 배열을 하나로 합쳐 `result`에 저장한다.
+    
+    - `unique`가 참이면, 두 배열에 모두 들어 있는 항목은 한 번만 저장한다.
+*/
+SORT_DEF int _sorted_merge_gallop(const int *s, int s_count, const int *l, int l_count, bool unique, int *result) {
+    int i = 0, j = 0, length = 0;
+    
+    for (; i < s_count; i++) {
+        int k = _gallop_lower_bound(l, j, l_count, s[i]);
+        
+        if (k > j) {
+            memcpy(&result[length], &l[j], (k - j) * sizeof(int));
+            
+            length += k - j;
+        }
+        
+        result[length++] = s[i];
+        
+        j = (unique && k < l_count && l[k] == s[i]) ? k + 1 : k;
+    }
+    
+    if (l_count - j > 0) {
+        memcpy(&result[length], &l[j], (l_count - j) * sizeof(int));
+        
+        length += l_count - j;
+    }
+    
+    return length;
+}
+
+/* 길이가 짧은 배열 `a`의 각 항목을 긴 배열 `b`에서 지수 탐색으로 찾아, 교집합을 `result`에 저장한다. */
+SORT_DEF int _sorted_intersection_gallop(const int *a, int a_count, const int *b, int b_count, int *result) {
+    int length = 0;
+    
+    for (int i = 0, j = 0; i < a_count && j < b_count; i++) {
+        j = _gallop_lower_bound(b, j, b_count, a[i]);
+        
+        if (j < b_count && b[j] == a[i]) result[length++] = a[i];
+    }
+    
+    return length;
+}
+
+/* 
+    배열 `a`와 `b`를 4개씩 묶어서 비교하고, 비교를 마친 위치를 `i`와 `j`에 저장한다.
+    
+    - `difference`가 `false`이면 두 배열에 모두 들어 있는 항목을, `true`이면 `a`에만 들어 있는
+      항목을 `result[length..]`에 저장한다.
+    - 아직 넘기지 않은 `a`의 묶음에서 `b`의 항목과 일치한 항목의 비트 마스크를 반환한다.
+*/
+SORT_DEF int _sorted_block_match(
+    const int *a, int a_count, int *i, 
+    const int *b, int b_count, int *j, 
+    bool difference, int *result, int *length
+) {
+    int mask = 0;
+    
+#if SORT_HAS_SSE2
+    while (*i + 4 <= a_count && *j + 4 <= b_count) {
+        __m128i a_block = _mm_loadu_si128((const __m128i *) &a[*i]);
+        __m128i b_block = _mm_loadu_si128((const __m128i *) &b[*j]);
+        
+        // `b`의 묶음을 한 칸씩 회전시키면서, `a`의 묶음과 4 x 4번 비교한다.
+        __m128i matches = _mm_cmpeq_epi32(a_block, b_block);
+        
+        b_block = _mm_shuffle_epi32(b_block, _MM_SHUFFLE(0, 3, 2, 1));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(a_block, b_block));
+        
+        b_block = _mm_shuffle_epi32(b_block, _MM_SHUFFLE(0, 3, 2, 1));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(a_block, b_block));
+        
+        b_block = _mm_shuffle_epi32(b_block, _MM_SHUFFLE(0, 3, 2, 1));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(a_block, b_block));
+        
+        STATS_ADD(comparisons, 16);
+        
+        int block_mask = _mm_movemask_ps(_mm_castsi128_ps(matches));
+        
+        if (!difference) {
+            for (int k = 0; k < 4; k++)
+                if (block_mask & (1 << k)) result[(*length)++] = a[*i + k];
+        }
+        
+        mask |= block_mask;
+        
+        int a_max = a[*i + 3], b_max = b[*j + 3];
+        
+        // 가장 큰 값이 더 작은 쪽의 묶음을 다음 묶음으로 넘긴다.
+        if (a_max <= b_max) {
+            if (difference) {
+                for (int k = 0; k < 4; k++)
+                    if (!(mask & (1 << k))) result[(*length)++] = a[*i + k];
+            }
+            
+            *i += 4;
+            mask = 0;
+        }
+        
+        if (b_max <= a_max) *j += 4;
+    }
+#else
+    (void) a, (void) a_count, (void) i, (void) b, (void) b_count, (void) j;
+    (void) difference, (void) result, (void) length;
+#endif
+    
+    return mask;
+}
+
+/* 중복 없이 정렬된 배열 `a`와 `b`의 교집합을 `result`에 저장하고, 그 길이를 반환한다. */
+SORT_DEF int sorted_intersection(const int *a, int a_count, const int *b, int b_count, int *result) {
+    /*
+        [교집합 연산의 동작 과정]
+        
+        1. 두 배열의 길이가 크게 차이 나면, 짧은 배열의 각 항목을 긴 배열에서 지수 탐색으로 찾는다.
+        2. 그렇지 않으면 두 배열을 4개씩 묶어서 SIMD 명령어로 한 번에 16번 비교하고,
+           가장 큰 값이 더 작은 쪽의 묶음을 다음 묶음으로 넘긴다.
+        3. 남은 항목은 두 배열을 한 칸씩 비교하며 처리한다.
+        
+        [교집합 연산의 성능]
+        
+        - 두 배열의 길이를 각각 `M`, `N` (`M <= N`)이라고 할 때, 지수 탐색을 사용하는 경우의
+          시간 복잡도는 `O(M * log(N / M))`이고, 그렇지 않은 경우의 시간 복잡도는 `O(M + N)`이다.
+    */
+    
+    if (a == NULL || b == NULL || result == NULL || a_count <= 0 || b_count <= 0) return 0;
+    
+    if ((long long) a_count * SORT_GALLOP_RATIO < b_count)
+        return _sorted_intersection_gallop(a, a_count, b, b_count, result);
+    
+    if ((long long) b_count * SORT_GALLOP_RATIO < a_count)
+        return _sorted_intersection_gallop(b, b_count, a, a_count, result);
+    
+    int i = 0, j = 0, length = 0;
+    
+    _sorted_block_match(a, a_count, &i, b, b_count, &j, false, result, &length);
+    
+    while (i < a_count && j < b_count) {
+        int x = a[i], y = b[j];
+        
+        if (STATS_CMP(x == y)) result[length++] = x;
+        
+        i += (x <= y);
+        j += (y <= x);
+    }
+    
+    return length;
+}
+
+/* 중복 없이 정렬된 배열 `a`와 `b`의 합집합을 `result`에 저장하고, 그 길이를 반환한다. */
+SORT_DEF int sorted_union(const int *a, int a_count, const int *b, int b_count, int *result) {
+    if (result == NULL) return 0;
+    
+    if (a == NULL || a_count < 0) a_count = 0;
+    if (b == NULL || b_count < 0) b_count = 0;
+    
+    // 한 배열이 훨씬 길면, 짧은 배열의 항목 사이에 들어갈 긴 배열의 구간을 한 번에 복사한다.
+    if ((long long) a_count * SORT_GALLOP_RATIO < b_count) 
+        return _sorted_merge_gallop(a, a_count, b, b_count, true, result);
+    
+    if ((long long) b_count * SORT_GALLOP_RATIO < a_count) 
+        return _sorted_merge_gallop(b, b_count, a, a_count, true, result);
+    
+    int i = 0, j = 0, length = 0;
+    
+    // 두 배열 중 더 작은 항목을 꺼내고, 같은 항목은 한 번만 저장한다.
+    while (i < a_count && j < b_count) {
+        int x = a[i], y = b[j];
+        
+        result[length++] = STATS_CMP(x < y) ? x : y;
+        
+        i += (x <= y);
+        j += (y <= x);
+    }
+    
+    // `a` 또는 `b`가 `NULL`일 수 있으므로, 남은 항목이 있을 때만 복사한다.
+    if (a_count - i > 0) {
+        memcpy(&result[length], &a[i], (a_count - i) * sizeof(int));
+        
+        length += a_count - i;
+    }
+    
+    if (b_count - j > 0) {
+        memcpy(&result[length], &b[j], (b_count - j) * sizeof(int));
+        
+        length += b_count - j;
+    }
+    
+    return length;
+}
+
+/* 중복 없이 정렬된 배열 `a`와 `b`의 차집합 (`a - b`)을 `result`에 저장하고, 그 길이를 반환한다. */
+SORT_DEF int sorted_difference(const int *a, int a_count, const int *b, int b_count, int *result) {
+    if (a == NULL || result == NULL || a_count <= 0) return 0;
+    
+    if (b == NULL || b_count <= 0) {
+        memmove(result, a, a_count * sizeof(int));
+        
+        return a_count;
+    }
+    
+    int i = 0, j = 0, length = 0;
+    
+    if ((long long) b_count * SORT_GALLOP_RATIO < a_count) {
+        // `b`의 각 항목을 `a`에서 찾고, 그 사이에 있는 항목을 한 번에 복사한다.
+        for (; j < b_count && i < a_count; j++) {
+            int k = _gallop_lower_bound(a, i, a_count, b[j]);
+            
+            memmove(&result[length], &a[i], (k - i) * sizeof(int));
+            length += k - i;
+            
+            i = (k < a_count && a[k] == b[j]) ? k + 1 : k;
+        }
+    } else if ((long long) a_count * SORT_GALLOP_RATIO < b_count) {
+        // `a`의 각 항목을 `b`에서 찾는다.
+        for (; i < a_count; i++) {
+            j = _gallop_lower_bound(b, j, b_count, a[i]);
+            
+            if (j >= b_count || b[j] != a[i]) result[length++] = a[i];
+        }
+        
+        return length;
+    } else {
+        int mask = _sorted_block_match(a, a_count, &i, b, b_count, &j, true, result, &length);
+        
+        int block_start = i;
+        
+        // 아직 넘기지 않은 묶음에서 이미 `b`와 일치한 항목은 건너뛴다.
+        while (i < a_count && j < b_count) {
+            int x = a[i], y = b[j];
+            
+            bool matched = (i - block_start < 4) && ((mask >> (i - block_start)) & 1);
+            
+            if (!matched && STATS_CMP(x < y)) result[length++] = x;
+            
+            i += (matched || x <= y);
+            j += (!matched && y <= x);
+        }
+        
+        for (; i < a_count && i - block_start < 4; i++)
+            if (!((mask >> (i - block_start)) & 1)) result[length++] = a[i];
+    }
+    
+    memmove(&result[length], &a[i], (a_count - i) * sizeof(int));
+    length += a_count - i;
+    
+    return length;
+}
+
+/* 정렬된 배열 `a`와 `b`를 하나로 합쳐 `result`에 저장하고, 그 길이를 반환한다. */
+SORT_DEF int sorted_merge(const int *a, int a_count, const int *b, int b_count, int *result) {
+    if (result == NULL) return 0;
+    
+    if (a == NULL || a_count < 0) a_count = 0;
+    if (b == NULL || b_count < 0) b_count = 0;
+    
+    // 한 배열이 훨씬 길면, 짧은 배열의 항목 사이에 들어갈 긴 배열의 구간을 한 번에 복사한다.
+    if ((long long) a_count * SORT_GALLOP_RATIO < b_count) 
+        return _sorted_merge_gallop(a, a_count, b, b_count, false, result);
+    
+    if ((long long) b_count * SORT_GALLOP_RATIO < a_count) 
+        return _sorted_merge_gallop(b, b_count, a, a_count, false, result);
+    
+    int i = 0, j = 0, length = 0;
+    
+    while (i < a_count && j < b_count) {
+        int x = a[i], y = b[j];
+        
+        int take_a = STATS_CMP(x <= y);
+        
+        result[length++] = take_a ? x : y;
+        
+        i += take_a;
+        j += !take_a;
+    }
+    
+    // `a` 또는 `b`가 `NULL`일 수 있으므로, 남은 항목이 있을 때만 복사한다.
+    if (a_count - i > 0) {
+        memcpy(&result[length], &a[i], (a_count - i) * sizeof(int));
+        
+        length += a_count - i;
+    }
+    
+    if (b_count - j > 0) {
+        memcpy(&result[length], &b[j], (b_count - j) * sizeof(int));
+        
+        length += b_count - j;
+    }
+    
+    return length;
+}
+
+/* 중복 없이 정렬된 배열 `k`개 (`arrays[0..(k - 1)]`)의 교집합을 `result`에 저장하고, 그 길이를 반환한다. */
+SORT_DEF int sorted_intersection_k(const int **arrays, const int *counts, int k, int *result) {
+    if (arrays == NULL || counts == NULL || result == NULL || k <= 0) return 0;
+    
+    int min_index = 0;
+    
+    // 가장 짧은 배열부터 시작하면, 중간 결과의 길이가 처음부터 가장 짧게 유지된다.
+    for (int i = 1; i < k; i++) {
+        if (counts[i] < counts[min_index])
+            min_index = i;
+    }
+    
+    if (arrays[min_index] == NULL || counts[min_index] <= 0) return 0;
+    
+    int length = counts[min_index];
+    
+    memmove(result, arrays[min_index], length * sizeof(int));
+    
+    for (int i = 0; i < k && length > 0; i++) {
+        if (i == min_index) continue;
+        
+        length = sorted_intersection(result, length, arrays[i], counts[i], result);
+    }
+    
+    return length;
+}
+
 #endif // `SORT_IMPLEMENTATION`
\ No newline at end of file
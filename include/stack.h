@@ -26,22 +26,65 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "trace.h"
 
 #define STACK_DEF static
 
+/* 스택 구조체 안에 직접 저장할 수 있는 값의 최대 개수. */
+#ifndef STACK_INLINE_CAPACITY
+    #define STACK_INLINE_CAPACITY 8
+#endif
+
 /* 스택을 나타내는 구조체. */
 typedef struct Stack {
     int length;
     int capacity;
+    int reserved;
     unsigned int *ptr;
+    Allocator allocator;
+    unsigned int inline_ptr[STACK_INLINE_CAPACITY];
 } Stack;
 
 /* 스택을 생성한다. */
 STACK_DEF Stack *stack_create(void);
 
+/* 메모리 할당자 `allocator`를 사용하는 스택을 생성한다. */
+STACK_DEF Stack *stack_create_with_allocator(const Allocator *allocator);
+
+/* 
+    값을 최대 `max_count`개까지 담을 수 있는 가상 메모리 공간을 미리 예약해 둔 스택을 생성한다.
+    
+    - 스택의 크기가 커지면 예약한 공간의 페이지를 필요한 만큼만 확정하므로, 
+      값을 복사하지 않고 각 값의 주소도 바뀌지 않는다.
+    - `huge_pages`가 `true`이면 투명한 거대 페이지 (THP)를 사용하도록 권고한다.
+    - 가상 메모리를 예약할 수 없으면 `stack_create()`와 같이 동작한다.
+*/
+STACK_DEF Stack *stack_create_reserved(int max_count, bool huge_pages);
+
 /* 스택 `stack`에 할당된 메모리를 해제한다. */
 STACK_DEF void stack_release(Stack *stack);
 
+/* 
+    스택 `stack`을 초기화한다.
+    
+    - 값이 `STACK_INLINE_CAPACITY`개를 넘기 전까지는 구조체 안의 내장 버퍼를 사용하므로,
+      지역 변수로 선언한 스택도 메모리를 할당하지 않고 사용할 수 있다.
+    - 구조체가 내장 버퍼의 주소를 가지고 있으므로, 초기화한 스택을 값으로 복사해서는 안 된다.
+*/
+STACK_DEF void stack_init(Stack *stack);
+
+/* `stack_init()`으로 초기화한 스택 `stack`이 내장 버퍼 밖에 할당한 메모리를 해제한다. */
+STACK_DEF void stack_deinit(Stack *stack);
+
+/* 스택 `stack`이 값을 `count`개까지 담을 수 있도록 공간을 확보한다. */
+STACK_DEF bool stack_reserve(Stack *stack, int count);
+
+/* 스택 `stack`이 사용하지 않는 공간을 해제한다. */
+STACK_DEF void stack_shrink_to_fit(Stack *stack);
+
 /* 스택 `stack`에 들어 있는 모든 값을 제거한다. */
 STACK_DEF void stack_clear(Stack *stack);
 
@@ -62,21 +105,174 @@ STACK_DEF int stack_peek(Stack *stack);
 
 #endif // `STACK_H`
 
-#ifdef STACK_IMPLEMENTATION
+/* 다른 헤더 파일을 통해 여러 번 포함되더라도 구현 부분은 한 번만 정의한다. */
+#if defined(STACK_IMPLEMENTATION) && !defined(STACK_IMPLEMENTATION_ONCE)
+#define STACK_IMPLEMENTATION_ONCE
 
 /* 스택을 생성한다. */
 STACK_DEF Stack *stack_create(void) {
-    Stack *result = calloc(1, sizeof(Stack));
+    return stack_create_with_allocator(NULL);
+}
+
+/* 메모리 할당자 `allocator`를 사용하는 스택을 생성한다. */
+STACK_DEF Stack *stack_create_with_allocator(const Allocator *allocator) {
+    Stack *result = allocator_alloc(allocator, sizeof(Stack));
+    
+    if (result == NULL) return NULL;
+    
+    stack_init(result);
     
-    result->capacity = 8;
-    result->ptr = calloc(result->capacity, sizeof(unsigned int));
+    if (allocator != NULL) result->allocator = *allocator;
+    
+    return result;
+}
+
+/* 값을 최대 `max_count`개까지 담을 수 있는 가상 메모리 공간을 미리 예약해 둔 스택을 생성한다. */
+STACK_DEF Stack *stack_create_reserved(int max_count, bool huge_pages) {
+    if (max_count <= 0) return NULL;
+    
+    size_t size = vm_round((size_t) max_count * sizeof(unsigned int));
+    
+    void *ptr = vm_reserve(size);
+    
+    if (ptr == NULL) return stack_create();
+    
+    if (huge_pages) vm_advise_huge_pages(ptr, size);
+    
+    if (!vm_commit(ptr, vm_page_size())) {
+        vm_release(ptr, size);
+        
+        return stack_create();
+    }
+    
+    Stack *result = allocator_alloc(NULL, sizeof(Stack));
+    
+    if (result == NULL) {
+        vm_release(ptr, size);
+        
+        return NULL;
+    }
+    
+    result->capacity = vm_page_size() / sizeof(unsigned int);
+    result->reserved = size / sizeof(unsigned int);
+    result->ptr = ptr;
     
     return result;
 }
 
 /* 스택 `stack`에 할당된 메모리를 해제한다. */
 STACK_DEF void stack_release(Stack *stack) {
-    free(stack);
+    if (stack == NULL) return;
+    
+    stack_deinit(stack);
+    
+    Allocator allocator = stack->allocator;
+    
+    allocator_free(&allocator, stack, sizeof(Stack));
+}
+
+/* 스택 `stack`을 초기화한다. */
+STACK_DEF void stack_init(Stack *stack) {
+    if (stack == NULL) return;
+    
+    memset(stack, 0, sizeof(Stack));
+    
+    stack->capacity = STACK_INLINE_CAPACITY;
+    stack->ptr = stack->inline_ptr;
+}
+
+/* `stack_init()`으로 초기화한 스택 `stack`이 내장 버퍼 밖에 할당한 메모리를 해제한다. */
+STACK_DEF void stack_deinit(Stack *stack) {
+    if (stack == NULL) return;
+    
+    if (stack->reserved > 0) 
+        vm_release(stack->ptr, stack->reserved * sizeof(unsigned int));
+    else if (stack->ptr != stack->inline_ptr) 
+        allocator_free(&stack->allocator, stack->ptr, stack->capacity * sizeof(unsigned int));
+    
+    stack->length = 0;
+    stack->capacity = STACK_INLINE_CAPACITY;
+    stack->reserved = 0;
+    stack->ptr = stack->inline_ptr;
+}
+
+/* 스택 `stack`의 버퍼 크기를 `capacity`로 바꾼다. */
+STACK_DEF bool _stack_resize_buffer(Stack *stack, int capacity) {
+    if (stack->reserved > 0) {
+        // 예약한 공간의 페이지를 확정하거나 되돌려 준다.
+        size_t old_size = stack->capacity * sizeof(unsigned int);
+        size_t new_size = vm_round(capacity * sizeof(unsigned int));
+        
+        if (new_size > stack->reserved * sizeof(unsigned int)) return false;
+        
+        unsigned char *ptr = (unsigned char *) stack->ptr;
+        
+        if (new_size > old_size && !vm_commit(ptr + old_size, new_size - old_size)) return false;
+        if (new_size < old_size) vm_decommit(ptr + new_size, old_size - new_size);
+        
+        stack->capacity = new_size / sizeof(unsigned int);
+    } else if (capacity <= STACK_INLINE_CAPACITY) {
+        // 값을 다시 내장 버퍼로 옮기고, 내장 버퍼 밖에 할당한 메모리를 해제한다.
+        if (stack->ptr != stack->inline_ptr) {
+            memcpy(stack->inline_ptr, stack->ptr, stack->length * sizeof(unsigned int));
+            
+            allocator_free(&stack->allocator, stack->ptr, stack->capacity * sizeof(unsigned int));
+        }
+        
+        stack->ptr = stack->inline_ptr;
+        stack->capacity = STACK_INLINE_CAPACITY;
+    } else if (stack->ptr == stack->inline_ptr) {
+        // 내장 버퍼가 가득 차면, 값을 새로 할당한 메모리로 옮긴다.
+        unsigned int *ptr = allocator_alloc(&stack->allocator, capacity * sizeof(unsigned int));
+        
+        if (ptr == NULL) return false;
+        
+        memcpy(ptr, stack->inline_ptr, stack->length * sizeof(unsigned int));
+        
+        stack->ptr = ptr;
+        stack->capacity = capacity;
+    } else {
+        unsigned int *ptr = allocator_realloc(
+            &stack->allocator, 
+            stack->ptr, 
+            stack->capacity * sizeof(unsigned int), 
+            capacity * sizeof(unsigned int)
+        );
+        
+        if (ptr == NULL) return false;
+        
+        stack->ptr = ptr;
+        stack->capacity = capacity;
+    }
+    
+    return true;
+}
+
+/* 스택 `stack`의 용량을 `capacity`로 바꾼다. */
+STACK_DEF bool _stack_resize(Stack *stack, int capacity) {
+    TRACE_BEGIN(resize);
+    
+    bool result = _stack_resize_buffer(stack, capacity);
+    
+    TRACE_END(resize, "stack_resize");
+    
+    return result;
+}
+
+/* 스택 `stack`이 값을 `count`개까지 담을 수 있도록 공간을 확보한다. */
+STACK_DEF bool stack_reserve(Stack *stack, int count) {
+    if (stack == NULL) return false;
+    
+    return (count <= stack->capacity) || _stack_resize(stack, count);
+}
+
+/* 스택 `stack`이 사용하지 않는 공간을 해제한다. */
+STACK_DEF void stack_shrink_to_fit(Stack *stack) {
+    if (stack == NULL) return;
+    
+    int capacity = (stack->length > STACK_INLINE_CAPACITY) ? stack->length : STACK_INLINE_CAPACITY;
+    
+    if (capacity < stack->capacity) _stack_resize(stack, capacity);
 }
 
 /* 스택 `stack`에 들어 있는 모든 값을 제거한다. */
@@ -99,8 +295,12 @@ STACK_DEF void stack_push(Stack *stack, unsigned int value) {
     if (stack == NULL) return;
     
     if (stack->length >= stack->capacity) {
-        stack->capacity *= 2;
-        stack->ptr = realloc(stack->ptr, 2 * stack->capacity * sizeof(unsigned int));
+        int capacity = 2 * stack->capacity;
+        
+        // 예약한 공간이 부족하면 남은 공간까지만 확정하고, 남은 공간이 없으면 값을 추가하지 않는다.
+        if (stack->reserved > 0 && capacity > stack->reserved) capacity = stack->reserved;
+        
+        if (capacity <= stack->capacity || !_stack_resize(stack, capacity)) return;
     }
     
     stack->ptr[stack->length++] = value;
@@ -0,0 +1,155 @@
+/*
+    Copyright (c) 2021 jdeokkim
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define STATS_DEF static
+
+/* 스레드마다 따로 존재하는 변수를 선언할 때 사용하는 키워드. */
+#ifndef ALGOLAB_THREAD_LOCAL
+    #if defined(__cplusplus) && __cplusplus >= 201103L
+        #define ALGOLAB_THREAD_LOCAL thread_local
+    #elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+        #define ALGOLAB_THREAD_LOCAL _Thread_local
+    #elif defined(__GNUC__) || defined(__clang__)
+        #define ALGOLAB_THREAD_LOCAL __thread
+    #elif defined(_MSC_VER)
+        #define ALGOLAB_THREAD_LOCAL __declspec(thread)
+    #else
+        #define ALGOLAB_THREAD_LOCAL
+    #endif
+#endif
+
+/* 정렬 알고리즘과 자료 구조의 실행 통계를 나타내는 구조체. */
+typedef struct Stats {
+    uint64_t comparisons;
+    uint64_t swaps;
+    uint64_t moves;
+    uint64_t recursion_depth;
+    uint64_t max_recursion_depth;
+    uint64_t allocations;
+    uint64_t reallocations;
+} Stats;
+
+/*
+    `ALGOLAB_STATS`가 정의되어 있으면 각 헤더 파일의 구현 부분에서 통계를 기록하고,
+    그렇지 않으면 아래의 매크로는 모두 아무것도 하지 않는다.
+*/
+#ifdef ALGOLAB_STATS
+    /* 
+        현재 스레드의 실행 통계.
+        
+        - 모든 소스 파일이 같은 통계를 공유하도록, `STATS_IMPLEMENTATION`을 정의한 
+          소스 파일 하나에서만 정의한다.
+    */
+    extern ALGOLAB_THREAD_LOCAL Stats _stats_local;
+
+    /* 현재 스레드의 실행 통계 항목 `field`의 값을 `n`만큼 늘린다. */
+    #define STATS_ADD(field, n) ((void) (_stats_local.field += (uint64_t) (n)))
+
+    /* 비교 연산 `expr`의 횟수를 기록하고, 그 결과를 반환한다. */
+    #define STATS_CMP(expr) (_stats_local.comparisons++, (expr))
+
+    /* 재귀 호출의 깊이를 1만큼 늘린다. */
+    #define STATS_ENTER() \
+        do { \
+            if (++_stats_local.recursion_depth > _stats_local.max_recursion_depth) \
+                _stats_local.max_recursion_depth = _stats_local.recursion_depth; \
+        } while (0)
+
+    /* 재귀 호출의 깊이를 1만큼 줄인다. */
+    #define STATS_LEAVE() ((void) (_stats_local.recursion_depth--))
+#else
+    #define STATS_ADD(field, n) ((void) 0)
+    #define STATS_CMP(expr) (expr)
+    #define STATS_ENTER() ((void) 0)
+    #define STATS_LEAVE() ((void) 0)
+#endif
+
+/* 현재 스레드의 실행 통계 항목 `field`의 값을 1만큼 늘린다. */
+#define STATS_COUNT(field) STATS_ADD(field, 1)
+
+/* 현재 스레드의 실행 통계를 반환한다. */
+STATS_DEF Stats stats_get(void);
+
+/* 현재 스레드의 실행 통계를 초기화한다. */
+STATS_DEF void stats_reset(void);
+
+/* 현재 스레드의 실행 통계를 `stream`에 출력한다. */
+STATS_DEF void stats_print(FILE *stream);
+
+#endif // `STATS_H`
+
+/* 다른 헤더 파일을 통해 여러 번 포함되더라도 구현 부분은 한 번만 정의한다. */
+#if defined(STATS_IMPLEMENTATION) && !defined(STATS_IMPLEMENTATION_ONCE)
+#define STATS_IMPLEMENTATION_ONCE
+
+#ifdef ALGOLAB_STATS
+    ALGOLAB_THREAD_LOCAL Stats _stats_local;
+#endif
+
+/* 현재 스레드의 실행 통계를 반환한다. */
+STATS_DEF Stats stats_get(void) {
+#ifdef ALGOLAB_STATS
+    return _stats_local;
+#else
+    Stats result;
+    
+    memset(&result, 0, sizeof(result));
+    
+    return result;
+#endif
+}
+
+/* 현재 스레드의 실행 통계를 초기화한다. */
+STATS_DEF void stats_reset(void) {
+#ifdef ALGOLAB_STATS
+    memset(&_stats_local, 0, sizeof(_stats_local));
+#endif
+}
+
+/* 현재 스레드의 실행 통계를 `stream`에 출력한다. */
+STATS_DEF void stats_print(FILE *stream) {
+    if (stream == NULL) return;
+    
+    Stats stats = stats_get();
+    
+    fprintf(
+        stream, 
+        "comparisons=%llu swaps=%llu moves=%llu max_recursion_depth=%llu "
+        "allocations=%llu reallocations=%llu\n",
+        (unsigned long long) stats.comparisons,
+        (unsigned long long) stats.swaps,
+        (unsigned long long) stats.moves,
+        (unsigned long long) stats.max_recursion_depth,
+        (unsigned long long) stats.allocations,
+        (unsigned long long) stats.reallocations
+    );
+}
+
+#endif // `STATS_IMPLEMENTATION`
\ No newline at end of file
@@ -0,0 +1,243 @@
+/*
+    Copyright (c) 2021 jdeokkim
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "stats.h"
+
+#define TRACE_DEF static
+
+/* 스레드마다 기록할 수 있는 구간의 최대 개수. 버퍼가 가득 차면 가장 오래된 구간부터 덮어쓴다. */
+#ifndef TRACE_BUFFER_CAPACITY
+    #define TRACE_BUFFER_CAPACITY 16384
+#endif
+
+/* 
+    정렬 알고리즘에서 이 길이보다 짧은 부분 배열을 처리하는 구간은 기록하지 않는다. 
+    짧은 구간까지 모두 기록하면 시각을 재는 비용이 정렬 시간보다 커지고, 큰 배열 하나를 
+    정렬하는 동안에도 링 버퍼가 여러 번 덮어쓰인다.
+*/
+#ifndef TRACE_MIN_SPAN_SIZE
+    #define TRACE_MIN_SPAN_SIZE 4096
+#endif
+
+/* 스레드 사이에서 공유하는 변수에 접근할 때 사용하는 원자적 연산. */
+#if defined(__GNUC__) || defined(__clang__)
+    #define TRACE_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define TRACE_ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+    #define TRACE_ATOMIC_FETCH_ADD(ptr, value) __atomic_fetch_add((ptr), (value), __ATOMIC_RELAXED)
+    #define TRACE_ATOMIC_CAS(ptr, expected, desired) \
+        __atomic_compare_exchange_n((ptr), (expected), (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#elif defined(ALGOLAB_TRACE)
+    #error "ALGOLAB_TRACE requires GCC or Clang atomic builtins"
+#endif
+
+/* 실행 구간 하나를 나타내는 구조체. */
+typedef struct TraceEvent {
+    const char *name;
+    uint64_t start;
+    uint64_t duration;
+} TraceEvent;
+
+/* 
+    스레드 하나의 실행 구간을 기록하는 링 버퍼를 나타내는 구조체.
+    
+    - 버퍼를 만든 스레드만 구간을 기록하므로, 기록할 때는 잠금이 필요 없다.
+    - `head`는 지금까지 기록한 구간의 개수이고, `tail`은 `trace_reset()`을 호출한 시점의 `head`이다.
+*/
+typedef struct TraceBuffer {
+    struct TraceBuffer *next;
+    uint32_t thread_id;
+    uint64_t head;
+    uint64_t tail;
+    TraceEvent events[TRACE_BUFFER_CAPACITY];
+} TraceBuffer;
+
+/* 
+    `ALGOLAB_TRACE`가 정의되어 있으면, 아래의 매크로로 실행 구간의 시작과 끝 시각을 기록한다.
+    그렇지 않으면 아래의 매크로는 모두 아무것도 하지 않는다.
+    
+    - 시각은 `sokol_time.h`의 `stm_now()`로 측정하므로, 한 소스 파일에서 `SOKOL_TIME_IMPL`을 
+      정의하고 `sokol_time.h`를 포함해야 하며, 측정을 시작하기 전에 `trace_setup()`을 호출해야 한다.
+    - 모든 소스 파일이 같은 링 버퍼 목록에 기록하도록, 한 소스 파일에서 `TRACE_IMPLEMENTATION`을 
+      정의해야 한다.
+    - 구간의 이름은 따옴표가 없는 문자열 리터럴이어야 한다.
+*/
+#ifdef ALGOLAB_TRACE
+    /*
+        `sokol_time.h`의 선언 부분은 `SOKOL_TIME_INCLUDED`로 보호되지만 구현 부분은 그렇지 않으므로, 
+        `SOKOL_TIME_IMPL`을 정의한 소스 파일에서 구현 부분이 두 번 정의되지 않도록 
+        아직 포함되지 않았을 때만 포함한다.
+    */
+    #ifndef SOKOL_TIME_INCLUDED
+        #include "sokol_time.h"
+    #endif
+
+    /* 모든 스레드의 링 버퍼 목록. */
+    extern TraceBuffer *_trace_buffers;
+
+    /* 지금까지 링 버퍼를 만든 스레드의 개수. */
+    extern uint32_t _trace_thread_count;
+
+    /* 현재 스레드의 링 버퍼. */
+    extern ALGOLAB_THREAD_LOCAL TraceBuffer *_trace_local;
+
+    /* 현재 스레드의 링 버퍼를 만들고, 링 버퍼 목록에 추가한다. */
+    static inline TraceBuffer *_trace_buffer_create(void) {
+        TraceBuffer *result = (TraceBuffer *) calloc(1, sizeof(TraceBuffer));
+        
+        if (result == NULL) return NULL;
+        
+        result->thread_id = TRACE_ATOMIC_FETCH_ADD(&_trace_thread_count, 1) + 1;
+        result->next = TRACE_ATOMIC_LOAD(&_trace_buffers);
+        
+        // 다른 스레드가 먼저 목록을 바꾸었으면, 바뀐 목록의 맨 앞에 다시 추가한다.
+        while (!TRACE_ATOMIC_CAS(&_trace_buffers, &result->next, result))
+            ;
+        
+        return (_trace_local = result);
+    }
+
+    /* 현재 스레드의 링 버퍼에 `start`부터 `end`까지의 실행 구간 `name`을 기록한다. */
+    static inline void _trace_record(const char *name, uint64_t start, uint64_t end) {
+        TraceBuffer *buffer = _trace_local;
+        
+        if (buffer == NULL && (buffer = _trace_buffer_create()) == NULL) return;
+        
+        uint64_t head = buffer->head;
+        
+        TraceEvent *event = &buffer->events[head % TRACE_BUFFER_CAPACITY];
+        
+        event->name = name;
+        event->start = start;
+        event->duration = end - start;
+        
+        // 구간을 모두 쓴 다음에 `head`를 늘려, `trace_dump()`가 쓰는 중인 구간을 읽지 않도록 한다.
+        TRACE_ATOMIC_STORE(&buffer->head, head + 1);
+    }
+
+    /* 실행 구간 `id`의 시작 시각을 기록한다. */
+    #define TRACE_BEGIN(id) TRACE_BEGIN_IF(id, true)
+
+    /* `cond`가 참일 때만 실행 구간 `id`의 시작 시각을 기록하고, `TRACE_END()`에서 그 구간을 저장한다. */
+    #define TRACE_BEGIN_IF(id, cond) \
+        bool _trace_enabled_##id = (cond); \
+        uint64_t _trace_start_##id = _trace_enabled_##id ? stm_now() : 0
+
+    /* 실행 구간 `id`의 끝 시각을 기록하고, 그 구간을 `name`이라는 이름으로 저장한다. */
+    #define TRACE_END(id, name) \
+        ((void) (_trace_enabled_##id && (_trace_record((name), _trace_start_##id, stm_now()), true)))
+#else
+    #define TRACE_BEGIN(id) ((void) 0)
+    #define TRACE_BEGIN_IF(id, cond) ((void) 0)
+    #define TRACE_END(id, name) ((void) 0)
+#endif
+
+/* 실행 구간의 시각을 측정할 수 있도록 타이머를 초기화한다. */
+TRACE_DEF void trace_setup(void);
+
+/* 모든 스레드에서 지금까지 기록한 실행 구간을 버린다. */
+TRACE_DEF void trace_reset(void);
+
+/* 
+    모든 스레드에서 기록한 실행 구간을 Chrome 트레이스 이벤트 형식의 JSON으로 `stream`에 출력한다.
+    
+    - 출력한 파일은 `chrome://tracing`이나 Perfetto (https://ui.perfetto.dev)에서 열 수 있다.
+    - 다른 스레드가 구간을 기록하는 중에 호출하면, 덮어쓰고 있는 구간이 잘못 출력될 수 있다.
+*/
+TRACE_DEF void trace_dump(FILE *stream);
+
+#endif // `TRACE_H`
+
+/* 다른 헤더 파일을 통해 여러 번 포함되더라도 구현 부분은 한 번만 정의한다. */
+#if defined(TRACE_IMPLEMENTATION) && !defined(TRACE_IMPLEMENTATION_ONCE)
+#define TRACE_IMPLEMENTATION_ONCE
+
+#ifdef ALGOLAB_TRACE
+    TraceBuffer *_trace_buffers;
+    
+    uint32_t _trace_thread_count;
+    
+    ALGOLAB_THREAD_LOCAL TraceBuffer *_trace_local;
+#endif
+
+/* 실행 구간의 시각을 측정할 수 있도록 타이머를 초기화한다. */
+TRACE_DEF void trace_setup(void) {
+#ifdef ALGOLAB_TRACE
+    stm_setup();
+#endif
+}
+
+/* 모든 스레드에서 지금까지 기록한 실행 구간을 버린다. */
+TRACE_DEF void trace_reset(void) {
+#ifdef ALGOLAB_TRACE
+    // 기록하는 스레드가 `head`를 바꾸는 것과 겹치지 않도록, 출력을 시작할 위치인 `tail`만 옮긴다.
+    for (TraceBuffer *buffer = TRACE_ATOMIC_LOAD(&_trace_buffers); buffer != NULL; buffer = buffer->next)
+        TRACE_ATOMIC_STORE(&buffer->tail, TRACE_ATOMIC_LOAD(&buffer->head));
+#endif
+}
+
+/* 모든 스레드에서 기록한 실행 구간을 Chrome 트레이스 이벤트 형식의 JSON으로 `stream`에 출력한다. */
+TRACE_DEF void trace_dump(FILE *stream) {
+    if (stream == NULL) return;
+    
+    fputs("{\"traceEvents\":[", stream);
+    
+#ifdef ALGOLAB_TRACE
+    bool is_first = true;
+    
+    for (TraceBuffer *buffer = TRACE_ATOMIC_LOAD(&_trace_buffers); buffer != NULL; buffer = buffer->next) {
+        uint64_t head = TRACE_ATOMIC_LOAD(&buffer->head);
+        uint64_t tail = TRACE_ATOMIC_LOAD(&buffer->tail);
+        
+        // 링 버퍼에 남아 있는 가장 오래된 구간부터 출력한다.
+        if (head - tail > TRACE_BUFFER_CAPACITY) tail = head - TRACE_BUFFER_CAPACITY;
+        
+        for (uint64_t i = tail; i < head; i++) {
+            TraceEvent *event = &buffer->events[i % TRACE_BUFFER_CAPACITY];
+            
+            fprintf(
+                stream, 
+                "%s\n{\"name\":\"%s\",\"cat\":\"algolab\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                "\"ts\":%.3f,\"dur\":%.3f}",
+                is_first ? "" : ",",
+                event->name,
+                (unsigned int) buffer->thread_id,
+                stm_us(event->start),
+                stm_us(event->duration)
+            );
+            
+            is_first = false;
+        }
+    }
+#endif
+    
+    fputs("\n],\"displayTimeUnit\":\"ns\"}\n", stream);
+}
+
+#endif // `TRACE_IMPLEMENTATION`
\ No newline at end of file